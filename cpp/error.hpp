@@ -20,6 +20,12 @@
  *   SET_ERROR_MESSAGE[W](error_t&, value, format_string, ...);
  *   SET_ERROR_STRING[W](error_t&, format_string, ...);
  *
+ *   Conversions are printf's, arguments are formatted by their own type
+ *   (%s takes std::string, string_view and wide strings too). With
+ *   YMH_ERR_WITH_CHECKED_FORMAT defined, C++20 checks format_string at
+ *   compile time, use runtime_format(s) for a format string built at
+ *   runtime.
+ *
  * (2) std::error_code or boost.system
  *
  *   SET_ERROR_CODE[W](error_t&, error_code);
@@ -40,6 +46,38 @@
  *   void error_t::dump(std::basic_ostream<CharT>&);
  *   void error_t::dump_backtrace(std::basic_ostream<CharT>&);
  *
+ * (6) Deferred Formatting
+ *
+ *   #define YMH_ERR_WITH_DEFERRED_FORMAT 1  // before include error.hpp
+ *
+ *   SET_ERROR_* keep format string and arguments (strings by contents),
+ *   they're formatted only if message() or dump[_backtrace]() is called.
+ *
+ * (7) Chain Storage
+ *
+ *   #define YMH_ERR_INLINE_FRAMES 4  // before include error.hpp
+ *
+ *   The first frames are stored in error_t, the rest on the heap. error_t
+ *   is move-only: error_t up = std::move(err);
+ *
+ * (8) Flight Recorder
+ *
+ *   #define YMH_ERR_WITH_FLIGHT_RECORDER 1  // before include error.hpp
+ *
+ *   SET_ERROR_* also append (time, site, domain, value) to a ring of the
+ *   thread, it keeps the last errors after error_t is cleared or gone.
+ *
+ *   std::vector<recorder::record> recorder::snapshot();  // all threads
+ *   void recorder::dump(std::basic_ostream<CharT>&);
+ *
+ * (9) Binary Chains
+ *
+ *   wire::encoder::encode(error_t const&, std::string& out, messages);
+ *   wire::decoder::decode(first, last, std::vector<wire::frame>&);
+ *   wire::dump_backtrace(std::vector<wire::frame> const&, ostrm);
+ *
+ *   Sites and domains are interned, see error_dump.cpp to print them.
+ *
  * [Usage]
  *
  *   using namespace ymh;
@@ -62,15 +100,22 @@
 #ifndef YMH_ERROR_HPP
 #define YMH_ERROR_HPP
 
+#include <algorithm>
 #include <codecvt>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <limits>
 #include <locale>
+#include <memory>
+#include <new>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <system_error>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 // #if defined(_MSVC_VER) && defined(_WIN32)
@@ -87,30 +132,73 @@
 #   include <boost/system/error_code.hpp>
 #endif  // YMH_ERR_WITH_BOOST_SYSTEM
 
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#   include <string_view>
+#   define YMH_ERR_HAS_STRING_VIEW 1
+#endif  // C++17
+
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304L
+#   define YMH_ERR_CONSTEXPR14 constexpr
+#else
+#   define YMH_ERR_CONSTEXPR14
+#endif  // __cpp_constexpr
+
+/* Format strings are checked at compile time if asked for, from C++20 */
+#if defined(YMH_ERR_WITH_CHECKED_FORMAT) \
+    && !(defined(__cpp_consteval) && defined(YMH_ERR_HAS_STRING_VIEW))
+#   undef YMH_ERR_WITH_CHECKED_FORMAT
+#endif  // YMH_ERR_WITH_CHECKED_FORMAT && !__cpp_consteval
+
+/* Frames of an error chain kept inside error_t before it allocates */
+#if !defined(YMH_ERR_INLINE_FRAMES)
+#   define YMH_ERR_INLINE_FRAMES 4
+#endif  // YMH_ERR_INLINE_FRAMES
+
+/* Last errors of every thread, see err::recorder */
+#if defined(YMH_ERR_WITH_FLIGHT_RECORDER)
+#   include <atomic>
+#   include <chrono>
+#   include <ctime>
+#   if !defined(YMH_ERR_FLIGHT_RECORDS)
+#       define YMH_ERR_FLIGHT_RECORDS 64  // per thread, a power of 2
+#   endif  // YMH_ERR_FLIGHT_RECORDS
+#   if !defined(YMH_ERR_FLIGHT_CLOCK)
+#       define YMH_ERR_FLIGHT_CLOCK ymh::err::detail::flight_clock
+#   endif  // YMH_ERR_FLIGHT_CLOCK
+#endif  // YMH_ERR_WITH_FLIGHT_RECORDER
+
+/* Source location of an error, the file is trimmed to "dir/file" at compile
+ * time, both are static strings kept by pointer. */
+#define YMH_ERR_FILE                                                    \
+    (__FILE__ + std::integral_constant<                                 \
+         std::size_t, ymh::err::detail::file_tail(__FILE__)>::value)
+
 /* User custom error message */
 #define SET_ERROR_CUSTOM(err, domain, val, fmt, ...)                    \
-    do { err.set_error_custom2(__FILE__, __LINE__, __FUNCTION__         \
+    do { err.set_error_custom2(YMH_ERR_FILE, __LINE__, __FUNCTION__     \
                                , domain, val, fmt, ##__VA_ARGS__); } while (0)
 
 /* User custom error message, except domain */
 #define SET_ERROR_MESSAGE(err, val, fmt, ...)                           \
-    do { err.set_error_message2(__FILE__, __LINE__, __FUNCTION__        \
+    do { err.set_error_message2(YMH_ERR_FILE, __LINE__, __FUNCTION__    \
                                 , val, fmt, ##__VA_ARGS__); } while (0)
 
 #define SET_ERROR_STRING(err, fmt, ...)                                 \
-    do { err.set_error_string2(__FILE__, __LINE__, __FUNCTION__         \
+    do { err.set_error_string2(YMH_ERR_FILE, __LINE__, __FUNCTION__     \
                                , fmt, ##__VA_ARGS__); } while (0)
 
 /* std::error_code or boost.system */
 #define SET_ERROR_CODE(err, ec)                                         \
-    do { err.set_error_code2(__FILE__, __LINE__, __FUNCTION__, ec); } while (0)
+    do { err.set_error_code2(YMH_ERR_FILE, __LINE__, __FUNCTION__, ec); \
+    } while (0)
 
 #define MAKE_ERROR_CODE(err, e)                                         \
-    do { err.make_error_code2(__FILE__, __LINE__, __FUNCTION__, e); } while (0)
+    do { err.make_error_code2(YMH_ERR_FILE, __LINE__, __FUNCTION__, e); \
+    } while (0)
 
 /* GetLastError() */
 #define SET_SYSTEM_ERROR(err, val)                                      \
-    do { err.set_system_error2(__FILE__, __LINE__, __FUNCTION__, val);  \
+    do { err.set_system_error2(YMH_ERR_FILE, __LINE__, __FUNCTION__, val); \
     } while (0)
 
 /* std::exception */
@@ -153,27 +241,27 @@
 #define __FUNCTION__W ymh::err::detail::a2w(__FUNCTION__)
 
 #define SET_ERROR_CUSTOMW(errW, domain, val, fmt, ...)                  \
-    do { errW.set_error_custom2(__FILE__W, __LINE__, __FUNCTION__W      \
+    do { errW.set_error_custom2(YMH_ERR_FILE, __LINE__, __FUNCTION__    \
                                 , domain, val, fmt, ##__VA_ARGS__); } while (0)
 
 #define SET_ERROR_MESSAGEW(errW, val, fmt, ...)                         \
-    do { errW.set_error_message2(__FILE__W, __LINE__, __FUNCTION__W     \
+    do { errW.set_error_message2(YMH_ERR_FILE, __LINE__, __FUNCTION__   \
                                  , val, fmt, ##__VA_ARGS__); } while (0)
 
 #define SET_ERROR_STRINGW(errW, fmt, ...)                               \
-    do { errW.set_error_string2(__FILE__W, __LINE__, __FUNCTION__W      \
+    do { errW.set_error_string2(YMH_ERR_FILE, __LINE__, __FUNCTION__    \
                                 , fmt, ##__VA_ARGS__); } while (0)
 
 #define SET_ERROR_CODEW(errW, ec)                                       \
-    do { errW.set_error_code2(__FILE__W, __LINE__, __FUNCTION__W, ec);  \
+    do { errW.set_error_code2(YMH_ERR_FILE, __LINE__, __FUNCTION__, ec); \
     } while (0)
 
 #define MAKE_ERROR_CODEW(errW, e)                                       \
-    do { errW.make_error_code2(__FILE__W, __LINE__, __FUNCTION__W, e);  \
+    do { errW.make_error_code2(YMH_ERR_FILE, __LINE__, __FUNCTION__, e); \
     } while (0)
 
 #define SET_SYSTEM_ERRORW(errW, val)                                    \
-    do { errW.set_system_error2(__FILE__W, __LINE__, __FUNCTION__W, val); \
+    do { errW.set_system_error2(YMH_ERR_FILE, __LINE__, __FUNCTION__, val); \
     } while (0)
 
 #define ERROR_TRYW try
@@ -220,108 +308,29 @@ namespace err
 {
 namespace detail
 {
-// Ensure l[w]printf's argument is available. Try make compile error,
-// because printf can't dump std::string.
-// e.g.
-//      std::string s("hello");
-//      std::printf("%s", s);
-inline void ensure_va_args_safe_A() {}
-template <class T, class... Args
-          , typename std::enable_if<
-                !std::is_class<T>::value && !std::is_same<
-                    typename std::remove_cv<
-                        typename std::remove_pointer<
-                            typename std::decay<T>::type>::type>::type
-                    , wchar_t>::value
-                , int>::type = 0>
-void ensure_va_args_safe_A(T const&, Args... args)
-{
-    ensure_va_args_safe_A(args...);
-}
-
-inline void ensure_va_args_safe_W() {}
-template <class T, class... Args
-          , typename std::enable_if<
-                !std::is_class<T>::value && !std::is_same<
-                    typename std::remove_cv<
-                        typename std::remove_pointer<
-                            typename std::decay<T>::type>::type>::type
-                    , char>::value
-                , int>::type = 0>
-void ensure_va_args_safe_W(T const&, Args... args)
-{
-    ensure_va_args_safe_W(args...);
-}
-
-// Construct string message from avarible arguments.
-//
-// @see s[w]printf
-template <class CharT>
-struct sprintf_constructor;
-
-template <>
-struct sprintf_constructor<char>
+// Position of the last c in s[0, end), or npos.
+constexpr std::size_t rfind_char(char const* s, char c, std::size_t end)
 {
-    using char_type = char;
-    using string_t = std::basic_string<char_type>;
-
-    template <class... Args>
-    static void construct(string_t& s, string_t const& fmt, Args&&... args)
-    {
-#if !defined(NDEBUG)
-        ensure_va_args_safe_A(std::forward<Args>(args)...);
-#endif
-        for (int n = BUFSIZ; true; n += BUFSIZ)
-        {
-            s.resize(n--);
-            auto r = std::snprintf(const_cast<char_type*>(s.data()), n
-                                   , fmt.c_str(), args...);
-            if (r < 0)
-            {
-                // TODO: throw system_error
-                s.clear();
-                break;
-            }
-            if (r < n)
-            {
-                s.resize(r);
-                break;
-            }
-        }
-    }
-};
+    return end == 0 ? static_cast<std::size_t>(-1)
+        : (s[end - 1] == c ? end - 1 : rfind_char(s, c, end - 1));
+}
 
-template <>
-struct sprintf_constructor<wchar_t>
+constexpr std::size_t file_tail(char const* path, std::size_t last
+                                , char sep)
 {
-    using char_type = wchar_t;
-    using string_t = std::basic_string<char_type>;
+    return (last == static_cast<std::size_t>(-1) || last == 0
+            || rfind_char(path, sep, last) == static_cast<std::size_t>(-1))
+        ? 0 : rfind_char(path, sep, last) + 1;
+}
 
-    template <class... Args>
-    static void construct(string_t& s, string_t const& fmt, Args&&... args)
-    {
-#if !defined(NDEBUG)
-        ensure_va_args_safe_W(std::forward<Args>(args)...);
-#endif
-        for (int n = BUFSIZ; true; n += BUFSIZ)
-        {
-            s.resize(n--);
-            auto r = std::swprintf(const_cast<char_type*>(s.data()), n
-                                   , fmt.c_str(), args...);
-            if (r < 0)
-            {
-                // TODO: throw system_error
-                s.clear();
-                break;
-            }
-            if (r < n)
-            {
-                s.resize(r);
-                break;
-            }
-        }
-    }
-};
+// Offset of "dir/file" in __FILE__, the parent directory is kept.
+template <std::size_t N>
+constexpr std::size_t file_tail(char const (&path)[N])
+{
+    return rfind_char(path, '/', N - 1) != static_cast<std::size_t>(-1)
+        ? file_tail(path, rfind_char(path, '/', N - 1), '/')
+        : file_tail(path, rfind_char(path, '\\', N - 1), '\\');
+}
 
 template <class CharT>
 struct ansi_constructor;
@@ -461,204 +470,1725 @@ inline std::wstring a2w(std::string const& from)
     return to;
 }
 
-// Internal error value structure.
-template <class CharT>
-class basic_errval
+// printf style conversion, e.g. "%-8.3f". Length modifiers are skipped,
+// the argument's type is known.
+struct format_spec
 {
-public:
-    using char_type = CharT;
-    using string_t = std::basic_string<char_type>;
+    bool left = false;
+    bool plus = false;
+    bool space = false;
+    bool alt = false;
+    bool zero = false;
+    int width = 0;
+    int precision = -1;
+    char conv = 0;
+};
 
-public:
-    basic_errval(string_t const& file, int line, string_t const& func
-                 , string_t const& domain2, int val, string_t const& msg)
-        : file_(file), line_(line), func_(func)
-        , domain_(domain2), val_(val), msg_(msg)
-    {}
+YMH_ERR_CONSTEXPR14 bool is_digit(int c)
+{
+    return '0' <= c && c <= '9';
+}
 
-    basic_errval(string_t const& domain2, int val, string_t const& msg)
-        : domain_(domain2), val_(val), msg_(msg)
-    {}
+YMH_ERR_CONSTEXPR14 int add_digit(int n, int c)
+{
+    return n < 100000 ? n * 10 + (c - '0') : n;
+}
 
-    basic_errval(string_t const& file, int line, string_t const& func
-                 , std::error_code const& ec)
-        : file_(file), line_(line), func_(func)
+// Parse the conversion after '%' at fmt[i], returns where it ends, or 0
+// if it isn't supported (e.g. '*' width, %n).
+template <class CharT>
+YMH_ERR_CONSTEXPR14 std::size_t parse_spec(CharT const* fmt, std::size_t i
+                                           , std::size_t n, format_spec& spec)
+{
+    for ( ; i < n; ++i)
+    {
+        auto const c = fmt[i];
+        if (c == '-')
+        {
+            spec.left = true;
+        }
+        else if (c == '+')
+        {
+            spec.plus = true;
+        }
+        else if (c == ' ')
+        {
+            spec.space = true;
+        }
+        else if (c == '#')
+        {
+            spec.alt = true;
+        }
+        else if (c == '0')
+        {
+            spec.zero = true;
+        }
+        else
+        {
+            break;
+        }
+    }
+    for ( ; i < n && is_digit(fmt[i]); ++i)
     {
-        std::string const cat_name(ec.category().name());
-        ansi_constructor<char_type>::construct(domain_, cat_name);
-        val_ = ec.value();
-        ansi_constructor<char_type>::construct(msg_, ec.message());
+        spec.width = add_digit(spec.width, fmt[i]);
     }
-
-    explicit basic_errval(std::error_code const& ec)
+    if (i < n && fmt[i] == '.')
+    {
+        spec.precision = 0;
+        for (++i; i < n && is_digit(fmt[i]); ++i)
+        {
+            spec.precision = add_digit(spec.precision, fmt[i]);
+        }
+    }
+    for ( ; i < n; ++i)
     {
-        std::string const cat_name(ec.category().name());
-        ansi_constructor<char_type>::construct(domain_, cat_name);
-        val_ = ec.value();
-        ansi_constructor<char_type>::construct(msg_, ec.message());
+        auto const c = fmt[i];
+        if (c != 'h' && c != 'l' && c != 'L' && c != 'q'
+            && c != 'j' && c != 'z' && c != 't')
+        {
+            break;
+        }
+    }
+    if (i == n)
+    {
+        return 0;
     }
+    switch (fmt[i])
+    {
+    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+    case 's': case 'p':
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+    case 'a': case 'A':
+        spec.conv = static_cast<char>(fmt[i]);
+        return i + 1;
+    default:
+        return 0;
+    }
+}
 
-#if defined(YMH_ERR_WITH_BOOST_SYSTEM)
+// An argument of a message, erased to what formatting needs.
+struct format_arg
+{
+    enum kind_t
+    {
+        integer, character, floating, text, wtext, pointer
+    };
+
+    kind_t kind;
+    bool is_signed;         // integer, character
+    bool is_long;           // floating: long double
+    long long i;            // integer, character
+    unsigned long long u;   // the same bits as unsigned of its own type
+    long double f;          // floating
+    void const* p;          // text or pointer, nullptr if null
+    std::size_t size;       // text: length in chars
+};
 
-    basic_errval(string_t const& file, int line, string_t const& func
-                 , boost::system::error_code const& ec)
-        : file_(file), line_(line), func_(func)
+template <class T>
+using decay_t = typename std::decay<T>::type;
+
+template <class T>
+struct identity
+{
+    using type = T;
+};
+
+template <class T>
+struct is_char_type : std::integral_constant<
+    bool, std::is_same<T, char>::value || std::is_same<T, signed char>::value
+          || std::is_same<T, unsigned char>::value
+          || std::is_same<T, wchar_t>::value
+          || std::is_same<T, char16_t>::value
+          || std::is_same<T, char32_t>::value>
+{};
+
+template <class T, class CharT>
+struct is_text_of : std::integral_constant<
+    bool, std::is_pointer<T>::value
+          && std::is_same<typename std::remove_cv<
+                              typename std::remove_pointer<T>::type>::type
+                          , CharT>::value>
+{};
+
+template <class CharT, class Traits, class Alloc>
+struct is_text_of<std::basic_string<CharT, Traits, Alloc>, CharT>
+    : std::true_type
+{};
+
+#if defined(YMH_ERR_HAS_STRING_VIEW)
+template <class CharT, class Traits>
+struct is_text_of<std::basic_string_view<CharT, Traits>, CharT>
+    : std::true_type
+{};
+#endif  // YMH_ERR_HAS_STRING_VIEW
+
+// format_arg::kind_t of T (decayed), or -1 if it can't be formatted.
+template <class T>
+struct arg_kind : std::integral_constant<
+    int, std::is_same<T, bool>::value ? format_arg::integer
+         : is_char_type<T>::value ? format_arg::character
+         : (std::is_integral<T>::value || std::is_enum<T>::value)
+             ? format_arg::integer
+         : std::is_floating_point<T>::value ? format_arg::floating
+         : is_text_of<T, char>::value ? format_arg::text
+         : is_text_of<T, wchar_t>::value ? format_arg::wtext
+         : (std::is_pointer<T>::value
+            || std::is_same<T, std::nullptr_t>::value) ? format_arg::pointer
+         : -1>
+{};
+
+template <class T, bool = std::is_enum<T>::value>
+struct integer_of
+{
+    using type = typename std::conditional<std::is_same<T, bool>::value
+                                           , int, T>::type;
+};
+
+template <class T>
+struct integer_of<T, true>
+{
+    using type = typename std::underlying_type<T>::type;
+};
+
+template <class T>
+void set_integer(format_arg& a, T const& v)
+{
+    using int_t = typename integer_of<T>::type;
+    using uint_t = typename std::make_unsigned<int_t>::type;
+    a.is_signed = std::is_signed<int_t>::value;
+    a.i = static_cast<long long>(static_cast<int_t>(v));
+    a.u = static_cast<unsigned long long>(
+        static_cast<uint_t>(static_cast<int_t>(v)));
+}
+
+template <class CharT>
+void set_text(format_arg& a, CharT const* s)
+{
+    a.p = s;
+    a.size = s ? std::char_traits<CharT>::length(s) : 0;
+}
+
+template <class CharT, class Traits, class Alloc>
+void set_text(format_arg& a, std::basic_string<CharT, Traits, Alloc> const& s)
+{
+    a.p = s.data();
+    a.size = s.size();
+}
+
+#if defined(YMH_ERR_HAS_STRING_VIEW)
+template <class CharT, class Traits>
+void set_text(format_arg& a, std::basic_string_view<CharT, Traits> const& s)
+{
+    a.p = s.data();
+    a.size = s.size();
+}
+#endif  // YMH_ERR_HAS_STRING_VIEW
+
+template <class T>
+void set_value(format_arg& a, T const& v
+               , std::integral_constant<int, format_arg::integer>)
+{
+    set_integer(a, v);
+}
+
+template <class T>
+void set_value(format_arg& a, T const& v
+               , std::integral_constant<int, format_arg::character>)
+{
+    set_integer(a, v);
+}
+
+template <class T>
+void set_value(format_arg& a, T const& v
+               , std::integral_constant<int, format_arg::floating>)
+{
+    a.is_long = std::is_same<T, long double>::value;
+    a.f = v;
+}
+
+template <class T>
+void set_value(format_arg& a, T const& v
+               , std::integral_constant<int, format_arg::text>)
+{
+    set_text(a, v);
+}
+
+template <class T>
+void set_value(format_arg& a, T const& v
+               , std::integral_constant<int, format_arg::wtext>)
+{
+    set_text(a, v);
+}
+
+template <class T>
+void set_value(format_arg& a, T const& v
+               , std::integral_constant<int, format_arg::pointer>)
+{
+    a.p = (void const*)(v);
+}
+
+template <class T>
+format_arg make_arg(T const& v)
+{
+    using kind = std::integral_constant<int, arg_kind<decay_t<T>>::value>;
+    static_assert(kind::value != -1
+                  , "argument can't be formatted, it must be arithmetic, enum"
+                    ", pointer or string");
+    format_arg a = format_arg();
+    a.kind = static_cast<format_arg::kind_t>(kind::value);
+    set_value(a, static_cast<decay_t<T> const&>(v), kind());
+    return a;
+}
+
+template <class T, std::size_t N>
+format_arg make_arg(T const (&v)[N])
+{
+    return make_arg(static_cast<T const*>(v));
+}
+
+// Whether conversion conv can format an argument of kind.
+YMH_ERR_CONSTEXPR14 bool accepts(char conv, int kind)
+{
+    switch (conv)
     {
-        std::string const cat_name(ec.category().name());
-        ansi_constructor<char_type>::construct(domain_, cat_name);
-        val_ = ec.value();
-        ansi_constructor<char_type>::construct(msg_, ec.message());
+    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+        return kind == format_arg::integer || kind == format_arg::character;
+    case 's':
+        return kind == format_arg::text || kind == format_arg::wtext;
+    case 'p':
+        return kind == format_arg::pointer || kind == format_arg::text
+            || kind == format_arg::wtext;
+    default:
+        return kind == format_arg::floating || kind == format_arg::integer;
     }
+}
 
-    explicit basic_errval(boost::system::error_code const& ec)
+// Fallback of conversions that don't accept the argument, used if the
+// format string isn't checked at compile time.
+inline char accepted_conv(char conv, int kind)
+{
+    if (accepts(conv, kind))
     {
-        std::string const cat_name(ec.category().name());
-        ansi_constructor<char_type>::construct(domain_, cat_name);
-        val_ = ec.value();
-        ansi_constructor<char_type>::construct(msg_, ec.message());
+        return conv;
     }
+    switch (kind)
+    {
+    case format_arg::integer:
+        return 'd';
+    case format_arg::character:
+        return 'c';
+    case format_arg::floating:
+        return 'g';
+    case format_arg::pointer:
+        return 'p';
+    default:
+        return 's';
+    }
+}
 
-#endif  // YMH_ERR_WITH_BOOST_SYSTEM
+#if defined(YMH_ERR_WITH_CHECKED_FORMAT)
+// Not constexpr: calling it while checking a format string at compile time
+// fails the compilation with the reason in the diagnostics.
+inline void format_error(char const*)
+{}
+#endif  // YMH_ERR_WITH_CHECKED_FORMAT
 
-    basic_errval() : basic_errval(std::error_code())
-    {}
+} // namespace detail
 
-    string_t domain() const
+// Format string that isn't known at compile time, e.g.
+//
+//      SET_ERROR_STRING(err, runtime_format(fmt), arg);
+template <class CharT>
+struct runtime_format_string
+{
+    CharT const* data;
+    std::size_t size;
+};
+
+inline runtime_format_string<char> runtime_format(std::string const& fmt)
+{
+    return {fmt.data(), fmt.size()};
+}
+
+inline runtime_format_string<wchar_t> runtime_format(std::wstring const& fmt)
+{
+    return {fmt.data(), fmt.size()};
+}
+
+// Format string of SET_ERROR_* with arguments, conversions are printf's.
+// In C++20 it's checked at compile time against the arguments' types.
+template <class CharT, class... Args>
+class basic_format_string
+{
+public:
+    using char_type = CharT;
+
+public:
+#if defined(YMH_ERR_WITH_CHECKED_FORMAT)
+    template <class S
+              , typename std::enable_if<
+                    std::is_convertible<
+                        S const&, std::basic_string_view<char_type>>::value
+                    , int>::type = 0>
+    consteval basic_format_string(S const& fmt)
+        : data_(std::basic_string_view<char_type>(fmt).data())
+        , size_(std::basic_string_view<char_type>(fmt).size())
     {
-        return domain_;
+        check();
     }
+#else
+    basic_format_string(char_type const* fmt)
+        : data_(fmt), size_(std::char_traits<char_type>::length(fmt))
+    {}
 
-    int value() const
+    basic_format_string(std::basic_string<char_type> const& fmt)
+        : data_(fmt.data()), size_(fmt.size())
+    {}
+#endif  // YMH_ERR_WITH_CHECKED_FORMAT
+
+    basic_format_string(runtime_format_string<char_type> fmt)
+        : data_(fmt.data), size_(fmt.size)
+    {}
+
+    char_type const* data() const
     {
-        return val_;
+        return data_;
     }
 
-    string_t message() const
+    std::size_t size() const
     {
-        return msg_;
+        return size_;
     }
 
-public:
-    void dump(std::basic_ostream<char_type>& ostrm, bool printfl=true) const
+private:
+#if defined(YMH_ERR_WITH_CHECKED_FORMAT)
+    consteval void check() const
     {
-        auto conv = [](std::string const& from) -> string_t
-                    {
-                        string_t to;
-                        ansi_constructor<char_type>::construct(to, from);
-                        return to;
-                    };
-
-        if (printfl)
+        constexpr int kinds[] = {
+            detail::arg_kind<detail::decay_t<Args>>::value..., 0};
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < size_; ++i)
         {
-            
-            // namespace fs = std::experimental::filesystem;
-            
-            // fs::path file(file_);
-            // fs::path file_cp;
-            // auto const n = std::distance(file.begin(), file.end());
-            // auto it = file.begin();
-            // if (1 < n)
-            // {
-            //     std::advance(it, n - 2);
-            //     file_cp /= *it++;
-            // }
-            // if (0 < n)
-            // {
-            //     file_cp /= *it++;
-            // }
-            
-            string_t file_cp = file_;
-            auto sep = ostrm.widen('/');
-            auto r1st_sep = file_.find_last_of(sep);
-            if (r1st_sep == string_t::npos)
+            if (data_[i] != '%')
             {
-                sep = ostrm.widen('\\');
-                r1st_sep = file_.find_last_of(sep);
+                continue;
             }
-            if (r1st_sep != string_t::npos)
+            if (i + 1 < size_ && data_[i + 1] == '%')
             {
-                auto const r2nd_sep = file_.find_last_of(sep, r1st_sep - 1);
-                if (r2nd_sep != string_t::npos)
-                {
-                    file_cp = file_.substr(r2nd_sep + 1);
-                }
+                ++i;
+                continue;
             }
-
-            ostrm << conv("File \"") << file_cp
-                  << conv("\", line ") << line_ << conv(", in ");
+            detail::format_spec spec;
+            auto const end = detail::parse_spec(data_, i + 1, size_, spec);
+            if (!end)
+            {
+                detail::format_error("unsupported conversion in format");
+            }
+            if (k == sizeof...(Args))
+            {
+                detail::format_error("too few arguments for format");
+            }
+            if (!detail::accepts(spec.conv, kinds[k]))
+            {
+                detail::format_error("argument doesn't match conversion");
+            }
+            ++k;
+            i = end - 1;
         }
-
-        ostrm << func_ << conv(": ") << msg_;
-        if (msg_.empty() || msg_.back() != '\n' || msg_.back() != L'\n')
+        if (k != sizeof...(Args))
         {
-            ostrm << std::endl;
+            detail::format_error("too many arguments for format");
         }
     }
+#endif  // YMH_ERR_WITH_CHECKED_FORMAT
 
 private:
-    string_t file_;
-    int line_ = 0;
-    string_t func_;
-
-private:
-    string_t domain_;
-    int val_ = 0;
-    string_t msg_;
+    char_type const* data_;
+    std::size_t size_;
 };
 
-} // namespace detail
+namespace detail
+{
 
-// Error storage structure.
+// Construct string message from arguments, after prefix.
+//
+// Each argument is converted once to a piece, then the string is sized
+// from the pieces and filled in one go.
 template <class CharT>
-class basic_error
+struct format_constructor
 {
-public:
     using char_type = CharT;
     using string_t = std::basic_string<char_type>;
-    using errval_t = detail::basic_errval<char_type>;
 
-public:
-    template <class... Args>
-    void set_error_custom(string_t const& domain2, int val
-                          , string_t const& fmt, Args&&... args)
+    static void construct(string_t& s
+                          , char_type const* prefix, std::size_t prefix_size
+                          , char_type const* fmt, std::size_t fmt_size
+                          , format_arg const* args, std::size_t n)
     {
-        errvals_.emplace_back(domain2
-                              , val, format(fmt, std::forward<Args>(args)...));
-    }
+        constexpr std::size_t local_pieces = 8;
+        piece local[local_pieces];
+        std::unique_ptr<piece[]> heap;
+        auto pieces = local;
+        if (local_pieces < n)
+        {
+            heap.reset(new piece[n]);
+            pieces = heap.get();
+        }
 
-    template <class... Args>
-    void set_error_message(int val, string_t const& fmt, Args&&... args)
-    {
-        string_t const empty_str;
-        set_error_custom(empty_str, val, fmt, std::forward<Args>(args)...);
+        std::size_t total = prefix_size;
+        walk(fmt, fmt_size, n
+             , [&total](char_type const*, std::size_t size)
+               {
+                   total += size;
+               }
+             , [&](std::size_t k, format_spec const& spec)
+               {
+                   total += convert(spec, args[k], pieces[k]);
+               });
+
+        using traits = std::char_traits<char_type>;
+        s.resize(total);
+        auto out = &s[0];
+        traits::copy(out, prefix, prefix_size);
+        out += prefix_size;
+        walk(fmt, fmt_size, n
+             , [&out](char_type const* text, std::size_t size)
+               {
+                   traits::copy(out, text, size);
+                   out += size;
+               }
+             , [&out, pieces](std::size_t k, format_spec const&)
+               {
+                   auto const& pc = pieces[k];
+                   traits::assign(out, pc.before, static_cast<char_type>(' '));
+                   out += pc.before;
+                   traits::copy(out, pc.head, pc.head_size);
+                   out += pc.head_size;
+                   traits::assign(out, pc.zeros, static_cast<char_type>('0'));
+                   out += pc.zeros;
+                   traits::copy(out, pc.body, pc.body_size);
+                   out += pc.body_size;
+                   traits::assign(out, pc.after, static_cast<char_type>(' '));
+                   out += pc.after;
+               });
     }
 
-    template <class... Args>
-    void set_error_string(string_t const& fmt, Args&&... args)
+private:
+    // before + head + zeros + body + after
+    struct piece
     {
-        constexpr int val = (std::numeric_limits<int>::max)();
-        set_error_message(val, fmt, std::forward<Args>(args)...);
-    }
-
-    void set_error_code(std::error_code const& ec)
+        std::size_t before = 0;
+        char_type head[2];
+        std::size_t head_size = 0;
+        std::size_t zeros = 0;
+        char_type const* body = nullptr;
+        std::size_t body_size = 0;
+        std::size_t after = 0;
+        char_type buf[64];
+        std::unique_ptr<string_t> spill;
+    };
+
+    // text runs and conversions of fmt, broken conversions and ones
+    // without an argument are kept as text.
+    template <class TextF, class ArgF>
+    static void walk(char_type const* fmt, std::size_t size, std::size_t n
+                     , TextF const& on_text, ArgF const& on_arg)
     {
-        errvals_.emplace_back(ec);
+        std::size_t from = 0;
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (fmt[i] != '%')
+            {
+                continue;
+            }
+            if (i + 1 < size && fmt[i + 1] == '%')
+            {
+                on_text(fmt + from, i - from);
+                from = ++i;
+                continue;
+            }
+            format_spec spec;
+            auto const end = parse_spec(fmt, i + 1, size, spec);
+            if (!end || k == n)
+            {
+                continue;
+            }
+            on_text(fmt + from, i - from);
+            on_arg(k++, spec);
+            from = end;
+            i = end - 1;
+        }
+        on_text(fmt + from, size - from);
     }
 
-    void make_error_code(std::errc e)
+    // body storage of the rare conversions that don't fit buf.
+    static string_t& spill(piece& pc)
     {
-        auto const ec = std::make_error_code(e);
-        set_error_code(ec);
+        pc.spill.reset(new string_t());
+        return *pc.spill;
     }
 
-#if defined(YMH_ERR_WITH_BOOST_SYSTEM)
-
-    void set_error_code(boost::system::error_code const& ec)
+    static void put_ascii(piece& pc, char const* s)
     {
-        errvals_.emplace_back(ec);
+        pc.body_size = 0;
+        for ( ; *s; ++s)
+        {
+            pc.buf[pc.body_size++] = static_cast<char_type>(*s);
+        }
+        pc.body = pc.buf;
     }
 
-    void make_error_code(boost::system::errc::errc_t e)
+    static void pad(format_spec const& spec, piece& pc, bool zero_pad)
+    {
+        auto const size = pc.head_size + pc.zeros + pc.body_size;
+        auto const width = static_cast<std::size_t>(spec.width);
+        if (width <= size)
+        {
+            return;
+        }
+        if (spec.left)
+        {
+            pc.after = width - size;
+        }
+        else if (zero_pad)
+        {
+            pc.zeros += width - size;
+        }
+        else
+        {
+            pc.before = width - size;
+        }
+    }
+
+    // digits of v in base 2^Bits, written backwards before last.
+    template <unsigned Bits>
+    static char_type* put_digits(char_type* last, unsigned long long v
+                                 , char const* digits)
+    {
+        for ( ; v; v >>= Bits)
+        {
+            *--last = static_cast<char_type>(digits[v & ((1u << Bits) - 1)]);
+        }
+        return last;
+    }
+
+    static void integer(format_spec const& spec, format_arg const& a
+                        , piece& pc)
+    {
+        auto const conv = spec.conv;
+        auto const is_decimal = (conv == 'd' || conv == 'i');
+        auto v = a.u;
+        auto const negative = is_decimal && a.is_signed && a.i < 0;
+        if (is_decimal && a.is_signed)
+        {
+            v = negative ? 0ULL - static_cast<unsigned long long>(a.i)
+                         : static_cast<unsigned long long>(a.i);
+        }
+
+        auto const last = pc.buf + sizeof(pc.buf) / sizeof(*pc.buf);
+        auto first = last;
+        if (conv == 'o')
+        {
+            first = put_digits<3>(first, v, "01234567");
+        }
+        else if (conv == 'x' || conv == 'X')
+        {
+            first = put_digits<4>(first, v, (conv == 'X') ? "0123456789ABCDEF"
+                                                          : "0123456789abcdef");
+        }
+        else
+        {
+            for (auto x = v; x; x /= 10)
+            {
+                *--first = static_cast<char_type>('0' + x % 10);
+            }
+        }
+        pc.body = first;
+        pc.body_size = static_cast<std::size_t>(last - first);
+
+        // precision is the minimum digits, 0 prints nothing for 0.
+        auto const precision = static_cast<std::size_t>(
+            spec.precision < 0 ? 1 : spec.precision);
+        pc.zeros = (pc.body_size < precision) ? precision - pc.body_size : 0;
+        if (conv == 'o' && spec.alt && !pc.zeros)
+        {
+            pc.zeros = 1;
+        }
+
+        if (negative || (is_decimal && (spec.plus || spec.space)))
+        {
+            pc.head[pc.head_size++] = static_cast<char_type>(
+                negative ? '-' : (spec.plus ? '+' : ' '));
+        }
+        else if ((conv == 'x' || conv == 'X') && spec.alt && v)
+        {
+            pc.head[pc.head_size++] = static_cast<char_type>('0');
+            pc.head[pc.head_size++] = static_cast<char_type>(conv);
+        }
+        pad(spec, pc, spec.zero && !spec.left && spec.precision < 0);
+    }
+
+    static void text(format_spec const& spec, format_arg const& a
+                     , piece& pc)
+    {
+        auto const same = (a.kind == format_arg::wtext)
+            == std::is_same<char_type, wchar_t>::value;
+        if (!a.p)
+        {
+            put_ascii(pc, "(null)");
+        }
+        else if (same)
+        {
+            pc.body = static_cast<char_type const*>(a.p);
+            pc.body_size = a.size;
+        }
+        else if (a.kind == format_arg::text)
+        {
+            auto& str = spill(pc);
+            ansi_constructor<char_type>::construct(
+                str, std::string(static_cast<char const*>(a.p), a.size));
+            pc.body = str.data();
+            pc.body_size = str.size();
+        }
+        else
+        {
+            auto& str = spill(pc);
+            ansi_constructor<char_type>::construct(
+                str, std::wstring(static_cast<wchar_t const*>(a.p), a.size));
+            pc.body = str.data();
+            pc.body_size = str.size();
+        }
+        if (0 <= spec.precision
+            && static_cast<std::size_t>(spec.precision) < pc.body_size)
+        {
+            pc.body_size = static_cast<std::size_t>(spec.precision);
+        }
+        pad(spec, pc, false);
+    }
+
+    static void pointer(format_spec const& spec, format_arg const& a
+                        , piece& pc)
+    {
+        if (!a.p)
+        {
+            put_ascii(pc, "(nil)");
+        }
+        else
+        {
+            format_arg x = format_arg();
+            x.u = reinterpret_cast<std::uintptr_t>(a.p);
+            format_spec hex;
+            hex.conv = 'x';
+            integer(hex, x, pc);
+            pc.head[0] = static_cast<char_type>('0');
+            pc.head[1] = static_cast<char_type>('x');
+            pc.head_size = 2;
+        }
+        pad(spec, pc, false);
+    }
+
+    // printf does floating point, width and flags included.
+    static void floating(format_spec const& spec, format_arg const& a
+                         , piece& pc)
+    {
+        char f[16] = {'%'};
+        std::size_t n = 1;
+        if (spec.left)
+        {
+            f[n++] = '-';
+        }
+        if (spec.plus)
+        {
+            f[n++] = '+';
+        }
+        if (spec.space)
+        {
+            f[n++] = ' ';
+        }
+        if (spec.alt)
+        {
+            f[n++] = '#';
+        }
+        if (spec.zero)
+        {
+            f[n++] = '0';
+        }
+        f[n++] = '*';
+        f[n++] = '.';
+        f[n++] = '*';
+        auto const is_long = (a.kind == format_arg::floating && a.is_long);
+        if (is_long)
+        {
+            f[n++] = 'L';
+        }
+        f[n++] = spec.conv;
+
+        auto const v = (a.kind == format_arg::floating) ? a.f
+            : a.is_signed ? static_cast<long double>(a.i)
+                          : static_cast<long double>(a.u);
+        auto print = [&](char* buf, std::size_t size) -> int
+        {
+            return is_long
+                ? std::snprintf(buf, size, f, spec.width, spec.precision, v)
+                : std::snprintf(buf, size, f, spec.width, spec.precision
+                                , static_cast<double>(v));
+        };
+
+        char buf[sizeof(pc.buf) / sizeof(*pc.buf)];
+        auto const r = print(buf, sizeof(buf));
+        auto const size = static_cast<std::size_t>(r < 0 ? 0 : r);
+        if (size < sizeof(buf))
+        {
+            std::copy(buf, buf + size, pc.buf);
+            pc.body = pc.buf;
+        }
+        else
+        {
+            std::string big(size + 1, '\0');
+            print(&big[0], big.size());
+            auto& str = spill(pc);
+            str.assign(big.begin(), big.begin() + size);
+            pc.body = str.data();
+        }
+        pc.body_size = size;
+    }
+
+    static std::size_t convert(format_spec spec, format_arg const& a
+                               , piece& pc)
+    {
+        spec.conv = accepted_conv(spec.conv, a.kind);
+        switch (spec.conv)
+        {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+            integer(spec, a, pc);
+            break;
+        case 'c':
+            pc.buf[0] = static_cast<char_type>(a.i);
+            pc.body = pc.buf;
+            pc.body_size = 1;
+            pad(spec, pc, false);
+            break;
+        case 's':
+            text(spec, a, pc);
+            break;
+        case 'p':
+            pointer(spec, a, pc);
+            break;
+        default:
+            floating(spec, a, pc);
+            break;
+        }
+        return pc.before + pc.head_size + pc.zeros + pc.body_size + pc.after;
+    }
+};
+
+// Format string and arguments of a message formatted when it is queried.
+//
+// They are packed after the domain in the record's string: sizes, the
+// format, the arguments, then the texts of string arguments (the caller's
+// buffer may be gone), converted to the record's char type.
+template <class CharT>
+class deferred_format
+{
+public:
+    using char_type = CharT;
+    using string_t = std::basic_string<char_type>;
+    using render_t = string_t (*)(char_type const* packed);
+
+    // s = prefix and packed fmt and args, returns how to format them.
+    static render_t pack(string_t& s
+                         , char_type const* prefix, std::size_t prefix_size
+                         , char_type const* fmt, std::size_t fmt_size
+                         , format_arg const* args, std::size_t n)
+    {
+        std::vector<string_t> converted;
+        auto units = prefix_size + header_units + fmt_size
+            + bytes_units(n * sizeof(format_arg));
+        for (std::size_t k = 0; k != n; ++k)
+        {
+            if (is_text(args[k]) && args[k].p)
+            {
+                units += text_of(args[k], converted).second;
+            }
+        }
+
+        s.reserve(units);
+        s.assign(prefix, prefix_size);
+        std::size_t const header[] = {fmt_size, n};
+        put_bytes(s, header, sizeof(header));
+        s.append(fmt, fmt_size);
+        auto const args_at = s.size();
+        put_bytes(s, args, n * sizeof(format_arg));
+        std::size_t next = 0;
+        for (std::size_t k = 0; k != n; ++k)
+        {
+            if (!is_text(args[k]))
+            {
+                continue;
+            }
+            format_arg a = args[k];
+            a.kind = std::is_same<char_type, wchar_t>::value
+                ? format_arg::wtext : format_arg::text;
+            if (a.p)
+            {
+                auto const text = text_of(args[k], converted, &next);
+                s.append(text.first, text.second);
+                a.size = text.second;
+            }
+            else
+            {
+                a.size = static_cast<std::size_t>(-1);
+            }
+            a.p = nullptr;
+            std::memcpy(reinterpret_cast<char*>(&s[args_at])
+                        + k * sizeof(format_arg), &a, sizeof(a));
+        }
+        return &render;
+    }
+
+private:
+    static constexpr std::size_t bytes_units(std::size_t bytes)
+    {
+        return (bytes + sizeof(char_type) - 1) / sizeof(char_type);
+    }
+
+    static constexpr std::size_t header_units
+        = (2 * sizeof(std::size_t) + sizeof(char_type) - 1)
+          / sizeof(char_type);
+
+    static bool is_text(format_arg const& a)
+    {
+        return a.kind == format_arg::text || a.kind == format_arg::wtext;
+    }
+
+    static void put_bytes(string_t& s, void const* p, std::size_t bytes)
+    {
+        auto const n = s.size();
+        s.resize(n + bytes_units(bytes));
+        if (bytes)
+        {
+            std::memcpy(&s[n], p, bytes);
+        }
+    }
+
+    // text of a string argument in char_type, the other char type is
+    // converted once into converted, next walks them while packing.
+    static std::pair<char_type const*, std::size_t> text_of(
+        format_arg const& a, std::vector<string_t>& converted
+        , std::size_t* next = nullptr)
+    {
+        auto const same = (a.kind == format_arg::wtext)
+            == std::is_same<char_type, wchar_t>::value;
+        if (same)
+        {
+            return {static_cast<char_type const*>(a.p), a.size};
+        }
+        if (next)
+        {
+            auto const& str = converted[(*next)++];
+            return {str.data(), str.size()};
+        }
+        string_t str;
+        if (a.kind == format_arg::text)
+        {
+            ansi_constructor<char_type>::construct(
+                str, std::string(static_cast<char const*>(a.p), a.size));
+        }
+        else
+        {
+            ansi_constructor<char_type>::construct(
+                str, std::wstring(static_cast<wchar_t const*>(a.p), a.size));
+        }
+        converted.push_back(std::move(str));
+        return {converted.back().data(), converted.back().size()};
+    }
+
+    static string_t render(char_type const* packed)
+    {
+        std::size_t header[2] = {};
+        std::memcpy(header, packed, sizeof(header));
+        auto const fmt = packed + header_units;
+        auto const fmt_size = header[0];
+        auto const n = header[1];
+
+        std::vector<format_arg> args(n);
+        auto p = fmt + fmt_size;
+        if (n)
+        {
+            std::memcpy(&args[0], p, n * sizeof(format_arg));
+        }
+        p += bytes_units(n * sizeof(format_arg));
+        for (auto& a : args)
+        {
+            if (is_text(a) && a.size != static_cast<std::size_t>(-1))
+            {
+                a.p = p;
+                p += a.size;
+            }
+        }
+
+        string_t s;
+        format_constructor<char_type>::construct(
+            s, fmt, 0, fmt, fmt_size, args.data(), n);
+        return s;
+    }
+};
+
+// Print narrow static strings (source location, category) to any stream.
+inline void put_narrow(std::ostream& ostrm, char const* s)
+{
+    ostrm << (s ? s : "");
+}
+
+inline void put_narrow(std::wostream& ostrm, char const* s)
+{
+    ostrm << a2w(s ? s : "");
+}
+
+// Internal error value structure.
+//
+// The source location points to static strings, error codes keep their
+// category, only custom domain and message are owned in one string.
+template <class CharT>
+class basic_errval
+{
+public:
+    using char_type = CharT;
+    using string_t = std::basic_string<char_type>;
+
+    using render_t = typename deferred_format<char_type>::render_t;
+
+public:
+    // text: domain (domain_size chars) followed by the message, or by the
+    // format and arguments for render if it's deferred.
+    basic_errval(char const* file, int line, char const* func
+                 , std::size_t domain_size, int val, string_t&& text
+                 , render_t render = nullptr)
+        : file_(file), line_(line), func_(func)
+        , val_(val), domain_size_(domain_size), text_(std::move(text))
+        , render_(render)
+    {}
+
+    basic_errval(char const* file, int line, char const* func
+                 , std::error_code const& ec)
+        : file_(file), line_(line), func_(func)
+        , category_(&ec.category()), val_(ec.value())
+    {}
+
+    explicit basic_errval(std::error_code const& ec)
+        : basic_errval(nullptr, 0, nullptr, ec)
+    {}
+
+#if defined(YMH_ERR_WITH_BOOST_SYSTEM)
+
+    basic_errval(char const* file, int line, char const* func
+                 , boost::system::error_code const& ec)
+        : file_(file), line_(line), func_(func)
+        , boost_category_(&ec.category()), val_(ec.value())
+    {}
+
+    explicit basic_errval(boost::system::error_code const& ec)
+        : basic_errval(nullptr, 0, nullptr, ec)
+    {}
+
+#endif  // YMH_ERR_WITH_BOOST_SYSTEM
+
+    basic_errval() : basic_errval(std::error_code())
+    {}
+
+    string_t domain() const
+    {
+        if (category_)
+        {
+            return conv(category_->name());
+        }
+#if defined(YMH_ERR_WITH_BOOST_SYSTEM)
+        if (boost_category_)
+        {
+            return conv(boost_category_->name());
+        }
+#endif  // YMH_ERR_WITH_BOOST_SYSTEM
+        return text_.substr(0, domain_size_);
+    }
+
+    int value() const
+    {
+        return val_;
+    }
+
+    char const* file() const
+    {
+        return file_;
+    }
+
+    int line() const
+    {
+        return line_;
+    }
+
+    char const* func() const
+    {
+        return func_;
+    }
+
+    // category of an error code, nullptr if it's a custom error.
+    std::error_category const* category() const
+    {
+        return category_;
+    }
+
+#if defined(YMH_ERR_WITH_BOOST_SYSTEM)
+
+    boost::system::error_category const* boost_category() const
+    {
+        return boost_category_;
+    }
+
+#endif  // YMH_ERR_WITH_BOOST_SYSTEM
+
+    // domain of a custom error without a copy.
+    std::pair<char_type const*, std::size_t> custom_domain() const
+    {
+        return {text_.data(), domain_size_};
+    }
+
+    // message of a custom error that isn't deferred without a copy, else
+    // nullptr.
+    std::pair<char_type const*, std::size_t> custom_message() const
+    {
+        if (category_ || render_)
+        {
+            return {nullptr, 0};
+        }
+#if defined(YMH_ERR_WITH_BOOST_SYSTEM)
+        if (boost_category_)
+        {
+            return {nullptr, 0};
+        }
+#endif  // YMH_ERR_WITH_BOOST_SYSTEM
+        return {text_.data() + domain_size_, text_.size() - domain_size_};
+    }
+
+    string_t message() const
+    {
+        if (category_)
+        {
+            return conv(category_->message(val_));
+        }
+#if defined(YMH_ERR_WITH_BOOST_SYSTEM)
+        if (boost_category_)
+        {
+            return conv(boost_category_->message(val_));
+        }
+#endif  // YMH_ERR_WITH_BOOST_SYSTEM
+        if (render_)
+        {
+            return render_(text_.c_str() + domain_size_);
+        }
+        return text_.substr(domain_size_);
+    }
+
+public:
+    void dump(std::basic_ostream<char_type>& ostrm, bool printfl=true) const
+    {
+        if (printfl)
+        {
+            put_narrow(ostrm, "File \"");
+            put_narrow(ostrm, file_);
+            put_narrow(ostrm, "\", line ");
+            ostrm << line_;
+            put_narrow(ostrm, ", in ");
+        }
+        put_narrow(ostrm, func_);
+        put_narrow(ostrm, ": ");
+
+        auto const msg = message();
+        ostrm << msg;
+        if (msg.empty() || msg.back() != '\n' || msg.back() != L'\n')
+        {
+            ostrm << std::endl;
+        }
+    }
+
+private:
+    static string_t conv(std::string const& from)
+    {
+        string_t to;
+        ansi_constructor<char_type>::construct(to, from);
+        return to;
+    }
+
+private:
+    char const* file_ = nullptr;
+    int line_ = 0;
+    char const* func_ = nullptr;
+
+private:
+    std::error_category const* category_ = nullptr;
+#if defined(YMH_ERR_WITH_BOOST_SYSTEM)
+    boost::system::error_category const* boost_category_ = nullptr;
+#endif  // YMH_ERR_WITH_BOOST_SYSTEM
+    int val_ = 0;
+    std::size_t domain_size_ = 0;
+    string_t text_;
+    render_t render_ = nullptr;
+};
+
+// Frames of an error chain, the first N are stored inline and the rest
+// spill to the heap. Moving takes the heap buffer or moves the frames,
+// it's never copied.
+template <class T, std::size_t N>
+class errval_chain
+{
+    static_assert(0 < N, "YMH_ERR_INLINE_FRAMES must be at least 1");
+
+public:
+    errval_chain() = default;
+
+    errval_chain(errval_chain&& other) noexcept
+    {
+        take(other);
+    }
+
+    errval_chain& operator=(errval_chain&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            take(other);
+        }
+        return *this;
+    }
+
+    errval_chain(errval_chain const&) = delete;
+    errval_chain& operator=(errval_chain const&) = delete;
+
+    ~errval_chain()
+    {
+        release();
+    }
+
+    template <class... Args>
+    void emplace_back(Args&&... args)
+    {
+        if (size_ == capacity_)
+        {
+            grow();
+        }
+        ::new (static_cast<void*>(data_ + size_)) T(
+            std::forward<Args>(args)...);
+        ++size_;
+    }
+
+    bool empty() const
+    {
+        return !size_;
+    }
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    T const& front() const
+    {
+        return data_[0];
+    }
+
+    T const* begin() const
+    {
+        return data_;
+    }
+
+    T const* end() const
+    {
+        return data_ + size_;
+    }
+
+    // destroys the frames, a heap buffer is kept for reuse.
+    void clear()
+    {
+        for (std::size_t i = 0; i != size_; ++i)
+        {
+            data_[i].~T();
+        }
+        size_ = 0;
+    }
+
+private:
+    bool is_local() const
+    {
+        return data_ == local();
+    }
+
+    T* local()
+    {
+        return reinterpret_cast<T*>(local_);
+    }
+
+    T const* local() const
+    {
+        return reinterpret_cast<T const*>(local_);
+    }
+
+    void grow()
+    {
+        auto const capacity = capacity_ * 2;
+        auto const data = static_cast<T*>(::operator new(capacity * sizeof(T)));
+        for (std::size_t i = 0; i != size_; ++i)
+        {
+            ::new (static_cast<void*>(data + i)) T(std::move(data_[i]));
+            data_[i].~T();
+        }
+        if (!is_local())
+        {
+            ::operator delete(data_);
+        }
+        data_ = data;
+        capacity_ = capacity;
+    }
+
+    void release()
+    {
+        clear();
+        if (!is_local())
+        {
+            ::operator delete(data_);
+        }
+        data_ = local();
+        capacity_ = N;
+    }
+
+    // other is left empty with its inline storage.
+    void take(errval_chain& other)
+    {
+        if (other.is_local())
+        {
+            for (std::size_t i = 0; i != other.size_; ++i)
+            {
+                ::new (static_cast<void*>(data_ + i)) T(
+                    std::move(other.data_[i]));
+            }
+            size_ = other.size_;
+            other.clear();
+            return;
+        }
+        data_ = other.data_;
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        other.data_ = other.local();
+        other.size_ = 0;
+        other.capacity_ = N;
+    }
+
+private:
+    alignas(T) unsigned char local_[N * sizeof(T)];
+    T* data_ = local();
+    std::size_t size_ = 0;
+    std::size_t capacity_ = N;
+};
+
+#if defined(YMH_ERR_WITH_FLIGHT_RECORDER)
+
+// Default clock of the flight recorder, a coarse wall clock is a few
+// nanoseconds where the precise one is tens.
+#if defined(__linux__) && defined(CLOCK_REALTIME_COARSE)
+struct flight_clock
+{
+    static std::int64_t now()
+    {
+        timespec ts;
+        ::clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+        return static_cast<std::int64_t>(ts.tv_sec) * 1000000000
+            + ts.tv_nsec;
+    }
+};
+#else
+struct flight_clock
+{
+    static std::int64_t now()
+    {
+        using namespace std::chrono;
+        return duration_cast<nanoseconds>(
+            system_clock::now().time_since_epoch()).count();
+    }
+};
+#endif  // __linux__ && CLOCK_REALTIME_COARSE
+
+// One record of a ring, a seqlock: seq is odd while it's written and
+// 2 * (index + 1) once it holds record index of its ring.
+struct alignas(64) flight_slot
+{
+    static constexpr std::size_t domain_words = 2;
+
+    std::atomic<std::uint64_t> seq{0};
+    std::atomic<std::int64_t> time{0};
+    std::atomic<std::uint64_t> thread{0};
+    std::atomic<char const*> file{nullptr};
+    std::atomic<char const*> func{nullptr};
+    std::atomic<int> line{0};
+    std::atomic<int> value{0};
+    std::atomic<std::uint64_t> domain[domain_words];
+};
+
+// Records of one thread at a time, written only by the thread that holds
+// it. Rings are never freed, a ring of an exited thread is kept with its
+// records until another thread takes it over.
+struct flight_ring
+{
+    static constexpr std::size_t size = YMH_ERR_FLIGHT_RECORDS;
+    static_assert(size && !(size & (size - 1))
+                  , "YMH_ERR_FLIGHT_RECORDS must be a power of 2");
+
+    std::atomic<std::uint64_t> head{0};     // records written
+    std::atomic<bool> in_use{true};
+    std::uint64_t thread = 0;               // serial of the holder
+    flight_ring* next = nullptr;            // fixed once it's listed
+    flight_slot slots[size];
+};
+
+inline std::atomic<flight_ring*>& flight_rings()
+{
+    static std::atomic<flight_ring*> rings{nullptr};
+    return rings;
+}
+
+inline std::uint64_t next_flight_thread()
+{
+    static std::atomic<std::uint64_t> serial{0};
+    return serial.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+// Takes a ring given up by an exited thread, or lists a new one.
+inline flight_ring* acquire_flight_ring()
+{
+    auto& rings = flight_rings();
+    flight_ring* r = rings.load(std::memory_order_acquire);
+    for ( ; r; r = r->next)
+    {
+        bool expected = false;
+        if (!r->in_use.load(std::memory_order_relaxed)
+            && r->in_use.compare_exchange_strong(expected, true
+                                                 , std::memory_order_acquire))
+        {
+            break;
+        }
+    }
+    if (!r)
+    {
+        // aligned by hand, new doesn't align to cache lines before C++17.
+        constexpr std::size_t align = alignof(flight_ring);
+        auto const raw = static_cast<char*>(
+            ::operator new(sizeof(flight_ring) + align));
+        auto const skew = reinterpret_cast<std::uintptr_t>(raw) % align;
+        r = ::new (static_cast<void*>(raw + (skew ? align - skew : 0)))
+            flight_ring();
+        r->next = rings.load(std::memory_order_relaxed);
+        while (!rings.compare_exchange_weak(r->next, r
+                                            , std::memory_order_release
+                                            , std::memory_order_relaxed))
+        {}
+    }
+    r->thread = next_flight_thread();
+    return r;
+}
+
+struct flight_ring_holder
+{
+    flight_ring* ring = nullptr;
+
+    ~flight_ring_holder()
+    {
+        if (ring)
+        {
+            ring->in_use.store(false, std::memory_order_release);
+        }
+    }
+};
+
+inline flight_ring& local_flight_ring()
+{
+    static thread_local flight_ring_holder holder;
+    if (!holder.ring)
+    {
+        holder.ring = acquire_flight_ring();
+    }
+    return *holder.ring;
+}
+
+// the domain truncated to fit words, a wide one as ASCII.
+inline void put_flight_domain(char* text, char const* domain
+                              , std::size_t size)
+{
+    std::memcpy(text, domain, size);
+}
+
+inline void put_flight_domain(char* text, wchar_t const* domain
+                              , std::size_t size)
+{
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        auto const c = domain[i];
+        text[i] = (static_cast<std::uint32_t>(c) < 0x80)
+            ? static_cast<char>(c) : '?';
+    }
+}
+
+template <class CharT>
+void flight_append(char const* file, int line, char const* func
+                   , CharT const* domain, std::size_t domain_size, int val)
+{
+    std::uint64_t words[flight_slot::domain_words] = {};
+    put_flight_domain(reinterpret_cast<char*>(words), domain
+                      , (std::min)(domain_size, sizeof(words) - 1));
+
+    auto& r = local_flight_ring();
+    auto const n = r.head.load(std::memory_order_relaxed);
+    auto& slot = r.slots[n & (flight_ring::size - 1)];
+    slot.seq.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.time.store(YMH_ERR_FLIGHT_CLOCK::now(), std::memory_order_relaxed);
+    slot.thread.store(r.thread, std::memory_order_relaxed);
+    slot.file.store(file, std::memory_order_relaxed);
+    slot.func.store(func, std::memory_order_relaxed);
+    slot.line.store(line, std::memory_order_relaxed);
+    slot.value.store(val, std::memory_order_relaxed);
+    for (std::size_t i = 0; i != flight_slot::domain_words; ++i)
+    {
+        slot.domain[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.seq.store(2 * n + 2, std::memory_order_release);
+    r.head.store(n + 1, std::memory_order_release);
+}
+
+template <class Category>
+void flight_append_code(char const* file, int line, char const* func
+                        , Category const& cat, int val)
+{
+    auto const name = cat.name();
+    flight_append(file, line, func, name, std::strlen(name), val);
+}
+
+#else
+
+template <class CharT>
+void flight_append(char const*, int, char const*
+                   , CharT const*, std::size_t, int)
+{}
+
+template <class Category>
+void flight_append_code(char const*, int, char const*, Category const&, int)
+{}
+
+#endif  // YMH_ERR_WITH_FLIGHT_RECORDER
+
+} // namespace detail
+
+#if defined(YMH_ERR_WITH_FLIGHT_RECORDER)
+
+// Last errors of every thread, kept after they're cleared.
+namespace recorder
+{
+
+// An error as it was recorded.
+struct record
+{
+    std::int64_t time;      // nanoseconds since the clock's epoch
+    std::uint64_t thread;   // serial of the recording thread, from 1
+    std::uint64_t index;    // order within its thread
+    char const* file;
+    int line;
+    char const* func;
+    char domain[16];        // truncated, wide non-ASCII as '?'
+    int value;
+};
+
+// Records of all threads merged by time, then by thread and order. A
+// record overwritten while it's read is left out.
+inline std::vector<record> snapshot()
+{
+    using detail::flight_ring;
+    using detail::flight_slot;
+    static_assert(sizeof(record::domain)
+                  == flight_slot::domain_words * sizeof(std::uint64_t)
+                  , "domain of record and slot differ");
+
+    std::vector<record> records;
+    auto r = detail::flight_rings().load(std::memory_order_acquire);
+    for ( ; r; r = r->next)
+    {
+        auto const head = r->head.load(std::memory_order_acquire);
+        auto const first = (flight_ring::size < head)
+            ? head - flight_ring::size : 0;
+        for (auto n = first; n != head; ++n)
+        {
+            auto const& slot = r->slots[n & (flight_ring::size - 1)];
+            auto const seq = slot.seq.load(std::memory_order_acquire);
+            if (seq != 2 * n + 2)
+            {
+                continue;
+            }
+            record rec;
+            rec.time = slot.time.load(std::memory_order_relaxed);
+            rec.thread = slot.thread.load(std::memory_order_relaxed);
+            rec.index = n;
+            rec.file = slot.file.load(std::memory_order_relaxed);
+            rec.line = slot.line.load(std::memory_order_relaxed);
+            rec.func = slot.func.load(std::memory_order_relaxed);
+            rec.value = slot.value.load(std::memory_order_relaxed);
+            std::uint64_t words[flight_slot::domain_words];
+            for (std::size_t i = 0; i != flight_slot::domain_words; ++i)
+            {
+                words[i] = slot.domain[i].load(std::memory_order_relaxed);
+            }
+            std::memcpy(rec.domain, words, sizeof(words));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) == seq)
+            {
+                records.push_back(rec);
+            }
+        }
+    }
+    std::sort(records.begin(), records.end()
+              , [](record const& a, record const& b)
+                {
+                    return a.time != b.time ? a.time < b.time
+                        : a.thread != b.thread ? a.thread < b.thread
+                        : a.index < b.index;
+                });
+    return records;
+}
+
+// One line per record:
+//   [1760000000.123456789 #2] File "a.cpp", line 3, in f: generic 2
+template <class CharT>
+void dump(std::basic_ostream<CharT>& ostrm)
+{
+    for (auto const& rec : snapshot())
+    {
+        char stamp[64];
+        std::snprintf(stamp, sizeof(stamp), "[%lld.%09lld #%llu] "
+                      , static_cast<long long>(rec.time / 1000000000)
+                      , static_cast<long long>(rec.time % 1000000000)
+                      , static_cast<unsigned long long>(rec.thread));
+        detail::put_narrow(ostrm, stamp);
+        detail::put_narrow(ostrm, "File \"");
+        detail::put_narrow(ostrm, rec.file);
+        detail::put_narrow(ostrm, "\", line ");
+        ostrm << rec.line;
+        detail::put_narrow(ostrm, ", in ");
+        detail::put_narrow(ostrm, rec.func);
+        detail::put_narrow(ostrm, ": ");
+        detail::put_narrow(ostrm, rec.domain);
+        ostrm << ' ' << rec.value << std::endl;
+    }
+}
+
+inline std::string dump()
+{
+    std::ostringstream ostrm;
+    dump(ostrm);
+    return ostrm.str();
+}
+
+} // namespace recorder
+
+#endif  // YMH_ERR_WITH_FLIGHT_RECORDER
+
+namespace wire
+{
+class encoder;
+} // namespace wire
+
+// Error storage structure.
+template <class CharT>
+class basic_error
+{
+    friend class wire::encoder;
+
+public:
+    using char_type = CharT;
+    using string_t = std::basic_string<char_type>;
+    using errval_t = detail::basic_errval<char_type>;
+
+public:
+    basic_error() = default;
+
+    // the chain is handed over, never copied.
+    basic_error(basic_error&&) = default;
+    basic_error& operator=(basic_error&&) = default;
+
+    basic_error(basic_error const&) = delete;
+    basic_error& operator=(basic_error const&) = delete;
+
+public:
+    // fmt without arguments is kept as it is.
+    template <class... Args>
+    using format_string = err::basic_format_string<
+        char_type, typename detail::identity<Args>::type...>;
+
+public:
+    template <class DomainT, class FmtT>
+    void set_error_custom(DomainT const& domain2, int val, FmtT const& fmt)
+    {
+        set_error_custom2(nullptr, 0, nullptr, domain2, val, fmt);
+    }
+
+    template <class DomainT, class... Args>
+    void set_error_custom(DomainT const& domain2, int val
+                          , format_string<Args...> fmt, Args&&... args)
+    {
+        set_error_custom2(nullptr, 0, nullptr
+                          , domain2, val, fmt, std::forward<Args>(args)...);
+    }
+
+    template <class FmtT>
+    void set_error_message(int val, FmtT const& fmt)
+    {
+        set_error_custom(empty_str(), val, fmt);
+    }
+
+    template <class... Args>
+    void set_error_message(int val, format_string<Args...> fmt
+                           , Args&&... args)
+    {
+        set_error_custom(empty_str(), val, fmt, std::forward<Args>(args)...);
+    }
+
+    template <class FmtT>
+    void set_error_string(FmtT const& fmt)
+    {
+        constexpr int val = (std::numeric_limits<int>::max)();
+        set_error_message(val, fmt);
+    }
+
+    template <class... Args>
+    void set_error_string(format_string<Args...> fmt, Args&&... args)
+    {
+        constexpr int val = (std::numeric_limits<int>::max)();
+        set_error_message(val, fmt, std::forward<Args>(args)...);
+    }
+
+    void set_error_code(std::error_code const& ec)
+    {
+        set_error_code2(nullptr, 0, nullptr, ec);
+    }
+
+    void make_error_code(std::errc e)
+    {
+        auto const ec = std::make_error_code(e);
+        set_error_code(ec);
+    }
+
+#if defined(YMH_ERR_WITH_BOOST_SYSTEM)
+
+    void set_error_code(boost::system::error_code const& ec)
+    {
+        set_error_code2(nullptr, 0, nullptr, ec);
+    }
+
+    void make_error_code(boost::system::errc::errc_t e)
     {
         auto const ec = boost::system::errc::make_error_code(e);
         set_error_code(ec);
@@ -682,7 +2212,7 @@ public:
     {
         if (errvals_.empty())
         {
-            return std::error_code().category().name();
+            return errval_t().domain();
         }
         return errvals_.front().domain();
     }
@@ -691,7 +2221,7 @@ public:
     {
         if (errvals_.empty())
         {
-            return std::error_code().value();
+            return errval_t().value();
         }
         return errvals_.front().value();
     }
@@ -700,7 +2230,7 @@ public:
     {
         if (errvals_.empty())
         {
-            return std::error_code().message();
+            return errval_t().message();
         }
         return errvals_.front().message();
     }
@@ -717,6 +2247,7 @@ public:
         {
             errval_t ev;
             ev.dump(ostrm, printfl);
+            return;
         }
         errvals_.front().dump(ostrm, printfl);
     }
@@ -770,41 +2301,68 @@ public:
     }
 
 public:
-    template <class... Args>
-    void set_error_custom2(string_t const& file, int line, string_t const& func
-                           , string_t const& domain2, int val
-                           , string_t const& fmt, Args&&... args)
+    // file and func must be static strings, e.g. __FILE__ and __FUNCTION__.
+    template <class DomainT, class FmtT>
+    void set_error_custom2(char const* file, int line, char const* func
+                           , DomainT const& domain2, int val, FmtT const& fmt)
+    {
+        add(file, line, func, text_of(domain2), val, text_of(fmt)
+            , nullptr, 0);
+    }
+
+    template <class DomainT, class... Args>
+    void set_error_custom2(char const* file, int line, char const* func
+                           , DomainT const& domain2, int val
+                           , format_string<Args...> fmt, Args&&... args)
+    {
+        detail::format_arg const fargs[] = {
+            detail::make_arg(args)..., detail::format_arg()};
+        add(file, line, func, text_of(domain2), val
+            , text_t(fmt.data(), fmt.size()), fargs, sizeof...(Args));
+    }
+
+    template <class FmtT>
+    void set_error_message2(char const* file, int line, char const* func
+                            , int val, FmtT const& fmt)
     {
-        errvals_.emplace_back(file, line, func
-                              , domain2, val
-                              , format(fmt, std::forward<Args>(args)...));
+        set_error_custom2(file, line, func, empty_str(), val, fmt);
     }
 
     template <class... Args>
-    void set_error_message2(string_t const& file, int line, string_t const& func
-                            , int val, string_t const& fmt, Args&&... args)
+    void set_error_message2(char const* file, int line, char const* func
+                            , int val, format_string<Args...> fmt
+                            , Args&&... args)
     {
-        string_t const empty_str;
-        set_error_custom2(file, line, func, empty_str
+        set_error_custom2(file, line, func, empty_str()
                           , val, fmt, std::forward<Args>(args)...);
     }
 
+    template <class FmtT>
+    void set_error_string2(char const* file, int line, char const* func
+                           , FmtT const& fmt)
+    {
+        constexpr int val = (std::numeric_limits<int>::max)();
+        set_error_message2(file, line, func, val, fmt);
+    }
+
     template <class... Args>
-    void set_error_string2(string_t const& file, int line, string_t const& func
-                           , string_t const& fmt, Args&&... args)
+    void set_error_string2(char const* file, int line, char const* func
+                           , format_string<Args...> fmt, Args&&... args)
     {
         constexpr int val = (std::numeric_limits<int>::max)();
         set_error_message2(file, line, func
                            , val, fmt, std::forward<Args>(args)...);
     }
 
-    void set_error_code2(string_t const& file, int line, string_t const& func
+    void set_error_code2(char const* file, int line, char const* func
                          , std::error_code const& ec)
     {
+        detail::flight_append_code(file, line, func, ec.category()
+                                   , ec.value());
         errvals_.emplace_back(file, line, func, ec);
     }
 
-    void make_error_code2(string_t const& file, int line, string_t const& func
+    void make_error_code2(char const* file, int line, char const* func
                           , std::errc e)
     {
         auto const ec = std::make_error_code(e);
@@ -813,13 +2371,15 @@ public:
 
 #if defined(YMH_ERR_WITH_BOOST_SYSTEM)
 
-    void set_error_code2(string_t const& file, int line, string_t const& func
+    void set_error_code2(char const* file, int line, char const* func
                          , boost::system::error_code const& ec)
     {
+        detail::flight_append_code(file, line, func, ec.category()
+                                   , ec.value());
         errvals_.emplace_back(file, line, func, ec);
     }
 
-    void make_error_code2(string_t const& file, int line, string_t const& func
+    void make_error_code2(char const* file, int line, char const* func
                           , boost::system::errc::errc_t e)
     {
         auto const ec = boost::system::errc::make_error_code(e);
@@ -828,7 +2388,7 @@ public:
 
 #endif  // YMH_ERR_WITH_BOOST_SYSTEM
 
-    void set_system_error2(string_t const& file, int line, string_t const& func
+    void set_system_error2(char const* file, int line, char const* func
                            , int val)
     {
         auto const ec = std::error_code(val, std::system_category());
@@ -836,31 +2396,640 @@ public:
     }
 
 private:
-    string_t format(string_t const& fmt) const
+    using traits_t = std::char_traits<char_type>;
+    using text_t = std::pair<char_type const*, std::size_t>;
+    using render_t = typename errval_t::render_t;
+
+    static char_type const* empty_str()
     {
-        return fmt;
+        static char_type const empty[1] = {};
+        return empty;
     }
 
-    template <class... Args>
-    string_t format(string_t const& fmt, Args&&... args) const
+    static text_t text_of(char_type const* s)
     {
-        string_t s;
-        detail::sprintf_constructor<char_type>::construct(
-            s, fmt.c_str(), std::forward<Args>(args)...);
-        return s;
+        s = s ? s : empty_str();
+        return text_t(s, traits_t::length(s));
+    }
+
+    static text_t text_of(string_t const& s)
+    {
+        return text_t(s.data(), s.size());
+    }
+
+    static text_t text_of(runtime_format_string<char_type> const& s)
+    {
+        return text_t(s.data, s.size);
+    }
+
+    // the record owns domain followed by the message, or by the format and
+    // arguments if YMH_ERR_WITH_DEFERRED_FORMAT, in one allocation.
+    void add(char const* file, int line, char const* func
+             , text_t domain2, int val, text_t fmt
+             , detail::format_arg const* args, std::size_t n)
+    {
+        string_t text;
+        render_t render = nullptr;
+        if (!n)
+        {
+            text.reserve(domain2.second + fmt.second);
+            text.assign(domain2.first, domain2.second)
+                .append(fmt.first, fmt.second);
+        }
+        else
+        {
+#if defined(YMH_ERR_WITH_DEFERRED_FORMAT)
+            render = detail::deferred_format<char_type>::pack(
+                text, domain2.first, domain2.second
+                , fmt.first, fmt.second, args, n);
+#else
+            detail::format_constructor<char_type>::construct(
+                text, domain2.first, domain2.second
+                , fmt.first, fmt.second, args, n);
+#endif  // YMH_ERR_WITH_DEFERRED_FORMAT
+        }
+        detail::flight_append(file, line, func
+                              , domain2.first, domain2.second, val);
+        errvals_.emplace_back(file, line, func, domain2.second, val
+                              , std::move(text), render);
     }
 
 private:
-    std::vector<errval_t> errvals_;
+    detail::errval_chain<errval_t, YMH_ERR_INLINE_FRAMES> errvals_;
 };
 
 using error_t = basic_error<char>;
 using werror_t = basic_error<wchar_t>;
 
+// Binary error chains for shipping backtraces, decoded back to the dump
+// format elsewhere (see error_dump.cpp).
+//
+// An encoder interns sites and domains: the first chain that has one
+// carries its strings, later ones only its id. The decoder must see the
+// chains of one encoder in order. All numbers are LEB128 varints, values
+// are zigzag encoded.
+//
+//   chain  = header(1 byte: 1, or 2 if the tables restart) count frame*
+//   frame  = site domain value message
+//   site   = 0 file line func (a new id) | id
+//   domain = 0 name (a new id) | 1 generic | 2 system | 3 iostream | id
+//   message = 0 (none) | size + 1, bytes, as text of the encoding process
+//   string = size, bytes
+namespace wire
+{
+
+namespace detail
+{
+
+enum : unsigned char
+{
+    chain_header = 1,
+    chain_header_restart = 2
+};
+
+enum : std::uint32_t
+{
+    new_entry = 0,
+    generic_domain = 1,
+    system_domain = 2,
+    iostream_domain = 3,
+    first_domain_id = 4,
+    first_site_id = 1,
+    max_entries = 4096     // tables restart beyond it
+};
+
+inline void put_varint(std::string& out, std::uint64_t v)
+{
+    while (0x80 <= v)
+    {
+        out.push_back(static_cast<char>((v & 0x7f) | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<char>(v));
+}
+
+inline void put_string(std::string& out, char const* s, std::size_t size)
+{
+    put_varint(out, size);
+    out.append(s, size);
+}
+
+inline bool get_varint(char const*& first, char const* last
+                       , std::uint64_t& v)
+{
+    v = 0;
+    for (unsigned shift = 0; first != last && shift < 64; shift += 7)
+    {
+        auto const byte = static_cast<unsigned char>(*first++);
+        v |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool get_string(char const*& first, char const* last
+                       , std::string& s, std::uint64_t size)
+{
+    if (static_cast<std::uint64_t>(last - first) < size)
+    {
+        return false;
+    }
+    s.assign(first, static_cast<std::size_t>(size));
+    first += size;
+    return true;
+}
+
+inline bool get_string(char const*& first, char const* last, std::string& s)
+{
+    std::uint64_t size = 0;
+    return get_varint(first, last, size) && get_string(first, last, s, size);
+}
+
+inline std::uint64_t zigzag(int v)
+{
+    auto const u = static_cast<std::uint32_t>(v);
+    return (v < 0) ? ((~u) << 1) | 1 : u << 1;
+}
+
+inline int unzigzag(std::uint64_t u)
+{
+    auto const v = static_cast<std::uint32_t>(u >> 1);
+    return static_cast<int>((u & 1) ? ~v : v);
+}
+
+inline void narrow(std::string& to, char const* s, std::size_t size)
+{
+    to.assign(s, size);
+}
+
+inline void narrow(std::string& to, wchar_t const* s, std::size_t size)
+{
+    err::detail::ansi_constructor<char>::construct(
+        to, std::wstring(s, size));
+}
+
+} // namespace detail
+
+// A frame as it was decoded.
+struct frame
+{
+    std::string file;
+    int line = 0;
+    std::string func;
+    std::string domain;
+    int value = 0;
+    bool has_message = false;
+    std::string message;
+};
+
+class encoder
+{
+public:
+    // Appends e to out, messages are kept only if messages is true, the
+    // decoder never rebuilds them (error values differ between platforms).
+    template <class CharT>
+    void encode(basic_error<CharT> const& e, std::string& out
+                , bool messages = true)
+    {
+        if (detail::max_entries <= sites_.size() + categories_.size()
+                                   + domains_.size() + messages_.size())
+        {
+            reset();
+        }
+        out.push_back(static_cast<char>(restart_ ? detail::chain_header_restart
+                                                 : detail::chain_header));
+        restart_ = false;
+        detail::put_varint(out, e.errvals_.size());
+        for (auto const& ev : e.errvals_)
+        {
+            put_site(out, ev);
+            put_domain(out, ev);
+            detail::put_varint(out, detail::zigzag(ev.value()));
+            if (!messages)
+            {
+                detail::put_varint(out, 0);
+                continue;
+            }
+            auto const msg = ev.custom_message();
+            if (msg.first)
+            {
+                put_message(out, msg.first, msg.second);
+                continue;
+            }
+            put_code_message(out, ev);
+        }
+    }
+
+    // Forgets the interned ids, the next chain restarts the tables.
+    void reset()
+    {
+        sites_.clear();
+        categories_.clear();
+        domains_.clear();
+        messages_.clear();
+        next_site_ = detail::first_site_id;
+        next_domain_ = detail::first_domain_id;
+        restart_ = true;
+    }
+
+private:
+    struct site_key
+    {
+        char const* file;
+        int line;
+        char const* func;
+
+        bool operator==(site_key const& other) const
+        {
+            return file == other.file && line == other.line
+                && func == other.func;
+        }
+    };
+
+    struct site_hash
+    {
+        std::size_t operator()(site_key const& k) const
+        {
+            auto h = std::hash<char const*>()(k.file);
+            h ^= std::hash<char const*>()(k.func) + 0x9e3779b9 + (h << 6)
+                 + (h >> 2);
+            return h ^ (static_cast<std::size_t>(k.line) * 0x9e3779b9);
+        }
+    };
+
+    struct code_key
+    {
+        void const* category;
+        int value;
+
+        bool operator==(code_key const& other) const
+        {
+            return category == other.category && value == other.value;
+        }
+    };
+
+    struct code_hash
+    {
+        std::size_t operator()(code_key const& k) const
+        {
+            return std::hash<void const*>()(k.category)
+                ^ (static_cast<std::size_t>(k.value) * 0x9e3779b9);
+        }
+    };
+
+    template <class ErrvalT>
+    void put_site(std::string& out, ErrvalT const& ev)
+    {
+        site_key const key = {ev.file(), ev.line(), ev.func()};
+        auto const it = sites_.find(key);
+        if (it != sites_.end())
+        {
+            detail::put_varint(out, it->second);
+            return;
+        }
+        sites_.emplace(key, next_site_++);
+        detail::put_varint(out, detail::new_entry);
+        auto const file = key.file ? key.file : "";
+        auto const func = key.func ? key.func : "";
+        detail::put_string(out, file, std::strlen(file));
+        detail::put_varint(out, static_cast<std::uint32_t>(key.line));
+        detail::put_string(out, func, std::strlen(func));
+    }
+
+    // std categories have fixed ids, the others are interned.
+    template <class ErrvalT>
+    void put_domain(std::string& out, ErrvalT const& ev)
+    {
+        if (auto const cat = ev.category())
+        {
+            if (*cat == std::generic_category())
+            {
+                detail::put_varint(out, detail::generic_domain);
+                return;
+            }
+            if (*cat == std::system_category())
+            {
+                detail::put_varint(out, detail::system_domain);
+                return;
+            }
+            if (*cat == std::iostream_category())
+            {
+                detail::put_varint(out, detail::iostream_domain);
+                return;
+            }
+            put_category(out, cat, cat->name());
+            return;
+        }
+#if defined(YMH_ERR_WITH_BOOST_SYSTEM)
+        if (auto const cat = ev.boost_category())
+        {
+            put_category(out, cat, cat->name());
+            return;
+        }
+#endif  // YMH_ERR_WITH_BOOST_SYSTEM
+        auto const domain = ev.custom_domain();
+        detail::narrow(text_, domain.first, domain.second);
+        auto const it = domains_.find(text_);
+        if (it != domains_.end())
+        {
+            detail::put_varint(out, it->second);
+            return;
+        }
+        domains_.emplace(text_, next_domain_);
+        put_new_domain(out, text_.data(), text_.size());
+    }
+
+    void put_category(std::string& out, void const* cat, char const* name)
+    {
+        auto const it = categories_.find(cat);
+        if (it != categories_.end())
+        {
+            detail::put_varint(out, it->second);
+            return;
+        }
+        categories_.emplace(cat, next_domain_);
+        put_new_domain(out, name, std::strlen(name));
+    }
+
+    template <class ErrvalT>
+    static void const* category_of(ErrvalT const& ev)
+    {
+#if defined(YMH_ERR_WITH_BOOST_SYSTEM)
+        if (ev.boost_category())
+        {
+            return ev.boost_category();
+        }
+#endif  // YMH_ERR_WITH_BOOST_SYSTEM
+        return ev.category();
+    }
+
+    // messages of error codes are the same for a value, they're cached,
+    // a deferred custom message is formatted each time.
+    template <class ErrvalT>
+    void put_code_message(std::string& out, ErrvalT const& ev)
+    {
+        code_key const key = {category_of(ev), ev.value()};
+        if (!key.category)
+        {
+            auto const formatted = ev.message();
+            put_message(out, formatted.data(), formatted.size());
+            return;
+        }
+        auto it = messages_.find(key);
+        if (it == messages_.end())
+        {
+            auto const formatted = ev.message();
+            detail::narrow(text_, formatted.data(), formatted.size());
+            it = messages_.emplace(key, text_).first;
+        }
+        put_message(out, it->second.data(), it->second.size());
+    }
+
+    static void put_message(std::string& out, char const* s, std::size_t size)
+    {
+        detail::put_varint(out, size + 1);
+        out.append(s, size);
+    }
+
+    void put_message(std::string& out, wchar_t const* s, std::size_t size)
+    {
+        detail::narrow(text_, s, size);
+        put_message(out, text_.data(), text_.size());
+    }
+
+    void put_new_domain(std::string& out, char const* name, std::size_t size)
+    {
+        ++next_domain_;
+        detail::put_varint(out, detail::new_entry);
+        detail::put_string(out, name, size);
+    }
+
+private:
+    std::unordered_map<site_key, std::uint32_t, site_hash> sites_;
+    std::unordered_map<void const*, std::uint32_t> categories_;
+    std::unordered_map<std::string, std::uint32_t> domains_;
+    std::unordered_map<code_key, std::string, code_hash> messages_;
+    std::uint32_t next_site_ = detail::first_site_id;
+    std::uint32_t next_domain_ = detail::first_domain_id;
+    bool restart_ = true;
+    std::string text_;
+};
+
+class decoder
+{
+public:
+    // Decodes the chain at first into frames and moves first past it,
+    // returns false if it's malformed or truncated.
+    bool decode(char const*& first, char const* last
+                , std::vector<frame>& frames)
+    {
+        frames.clear();
+        if (first == last)
+        {
+            return false;
+        }
+        auto const header = static_cast<unsigned char>(*first++);
+        if (header == detail::chain_header_restart)
+        {
+            sites_.clear();
+            domains_.clear();
+        }
+        else if (header != detail::chain_header)
+        {
+            return false;
+        }
+
+        std::uint64_t count = 0;
+        if (!get_varint(first, last, count)
+            || static_cast<std::uint64_t>(last - first) < count)
+        {
+            return false;
+        }
+        frames.resize(static_cast<std::size_t>(count));
+        for (auto& f : frames)
+        {
+            if (!get_site(first, last, f) || !get_domain(first, last, f)
+                || !get_message(first, last, f))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    struct site
+    {
+        std::string file;
+        int line;
+        std::string func;
+    };
+
+    static bool get_varint(char const*& first, char const* last
+                           , std::uint64_t& v)
+    {
+        return detail::get_varint(first, last, v);
+    }
+
+    bool get_site(char const*& first, char const* last, frame& f)
+    {
+        std::uint64_t id = 0;
+        if (!get_varint(first, last, id))
+        {
+            return false;
+        }
+        if (id == detail::new_entry)
+        {
+            site st;
+            std::uint64_t line = 0;
+            if (!detail::get_string(first, last, st.file)
+                || !get_varint(first, last, line)
+                || !detail::get_string(first, last, st.func))
+            {
+                return false;
+            }
+            st.line = static_cast<int>(static_cast<std::uint32_t>(line));
+            sites_.push_back(std::move(st));
+            id = sites_.size() - 1 + detail::first_site_id;
+        }
+        auto const k = id - detail::first_site_id;
+        if (id < detail::first_site_id || sites_.size() <= k)
+        {
+            return false;
+        }
+        auto const& st = sites_[static_cast<std::size_t>(k)];
+        f.file = st.file;
+        f.line = st.line;
+        f.func = st.func;
+        return true;
+    }
+
+    bool get_domain(char const*& first, char const* last, frame& f)
+    {
+        std::uint64_t id = 0;
+        std::uint64_t value = 0;
+        if (!get_varint(first, last, id))
+        {
+            return false;
+        }
+        std::error_category const* cat = nullptr;
+        switch (id)
+        {
+        case detail::new_entry:
+            domains_.emplace_back();
+            if (!detail::get_string(first, last, domains_.back()))
+            {
+                return false;
+            }
+            id = domains_.size() - 1 + detail::first_domain_id;
+            break;
+        case detail::generic_domain:
+            cat = &std::generic_category();
+            break;
+        case detail::system_domain:
+            cat = &std::system_category();
+            break;
+        case detail::iostream_domain:
+            cat = &std::iostream_category();
+            break;
+        default:
+            break;
+        }
+        if (!get_varint(first, last, value))
+        {
+            return false;
+        }
+        f.value = detail::unzigzag(value);
+        if (cat)
+            // its message is sent, values differ between platforms.
+        {
+            f.domain = cat->name();
+            return true;
+        }
+        auto const k = id - detail::first_domain_id;
+        if (domains_.size() <= k)
+        {
+            return false;
+        }
+        f.domain = domains_[static_cast<std::size_t>(k)];
+        return true;
+    }
+
+    bool get_message(char const*& first, char const* last, frame& f)
+    {
+        std::uint64_t size = 0;
+        if (!get_varint(first, last, size))
+        {
+            return false;
+        }
+        if (!size)
+        {
+            return true;
+        }
+        f.has_message = true;
+        return detail::get_string(first, last, f.message, size - 1);
+    }
+
+private:
+    std::vector<site> sites_;
+    std::vector<std::string> domains_;
+};
+
+// Same as basic_error::dump_backtrace(), a frame without its message has
+// "domain value" instead.
+template <class CharT>
+void dump_backtrace(std::vector<frame> const& frames
+                    , std::basic_ostream<CharT>& ostrm, bool printfl = true)
+{
+    if (frames.empty())
+    {
+        frame f;
+        f.domain = std::generic_category().name();
+        f.has_message = true;
+        f.message = std::generic_category().message(0);
+        dump_backtrace(std::vector<frame>(1, f), ostrm, printfl);
+    }
+    for (auto const& f : frames)
+    {
+        if (printfl)
+        {
+            err::detail::put_narrow(ostrm, "File \"");
+            err::detail::put_narrow(ostrm, f.file.c_str());
+            err::detail::put_narrow(ostrm, "\", line ");
+            ostrm << f.line;
+            err::detail::put_narrow(ostrm, ", in ");
+        }
+        err::detail::put_narrow(ostrm, f.func.c_str());
+        err::detail::put_narrow(ostrm, ": ");
+        if (f.has_message)
+        {
+            err::detail::put_narrow(ostrm, f.message.c_str());
+        }
+        else
+        {
+            err::detail::put_narrow(ostrm, f.domain.c_str());
+            ostrm << ' ' << f.value;
+        }
+        ostrm << std::endl;
+    }
+}
+
+} // namespace wire
+
 } // namespace err
 
 using err::error_t;
 using err::werror_t;
+using err::runtime_format;
+
+#if defined(YMH_ERR_WITH_FLIGHT_RECORDER)
+namespace recorder = err::recorder;
+#endif  // YMH_ERR_WITH_FLIGHT_RECORDER
+
+namespace wire = err::wire;
 
 } // namespace ymh
 
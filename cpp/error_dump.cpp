@@ -0,0 +1,68 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#   include <fcntl.h>
+#   include <io.h>
+#endif  // _WIN32
+
+#include "error.hpp"
+
+/* Print binary error chains of one ymh::wire::encoder in the format
+ * of error_t::dump_backtrace(), a blank line between chains.
+ *
+ *      error_dump [file]       // stdin if no file
+ */
+int main(int argc, char* argv[])
+{
+    if (2 < argc)
+    {
+        std::cerr << "usage: " << argv[0] << " [file]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string data;
+    if (argc == 2)
+    {
+        std::ifstream ifile(argv[1], std::ios_base::binary);
+        if (!ifile)
+        {
+            std::cerr << argv[0] << ": can't open " << argv[1] << std::endl;
+            return EXIT_FAILURE;
+        }
+        data.assign(std::istreambuf_iterator<char>(ifile)
+                    , std::istreambuf_iterator<char>());
+    }
+    else
+    {
+#if defined(_WIN32)
+        _setmode(_fileno(stdin), _O_BINARY);
+#endif  // _WIN32
+        data.assign(std::istreambuf_iterator<char>(std::cin)
+                    , std::istreambuf_iterator<char>());
+    }
+
+    ymh::wire::decoder dec;
+    std::vector<ymh::wire::frame> frames;
+    char const* first = data.data();
+    char const* const last = data.data() + data.size();
+    for (std::size_t n = 0; first != last; ++n)
+    {
+        auto const at = first - data.data();
+        if (!dec.decode(first, last, frames))
+        {
+            std::cerr << argv[0] << ": bad chain at byte " << at << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (n)
+        {
+            std::cout << std::endl;
+        }
+        ymh::wire::dump_backtrace(frames, std::cout);
+    }
+    return EXIT_SUCCESS;
+}
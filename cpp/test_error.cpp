@@ -1,6 +1,8 @@
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <vector>
 
 /* Include boost.system before error.hpp 
  * if want to use:
@@ -85,8 +87,58 @@ bool Foo(ymh::error_t& e)
     return true;
 }
 
+static int fail(char const* what)
+{
+    std::cout << "Error: " << what << std::endl;
+    return EXIT_FAILURE;
+}
+
 int main()
 {
+    // a chain longer than the inline frames survives moves.
+    ymh::error_t chain;
+    for (int i = 0; i != YMH_ERR_INLINE_FRAMES + 3; ++i)
+    {
+        SET_ERROR_STRING(chain, "frame %d", i);
+    }
+    auto const frames = chain.dump_backtrace(false);
+    ymh::error_t moved(std::move(chain));
+    ymh::error_t assigned;
+    SET_ERROR_STRING(assigned, "replaced");
+    assigned = std::move(moved);
+    if (assigned.dump_backtrace(false) != frames
+        || assigned.message() != "frame 0"
+        || frames.find("frame " + std::to_string(YMH_ERR_INLINE_FRAMES + 2))
+           == std::string::npos)
+    {
+        return fail("error chain differs after move");
+    }
+
+    // chains decoded from the wire print as they were.
+    ymh::error_t coded;
+    MAKE_ERROR_CODE(coded, std::errc::no_such_file_or_directory);
+    SET_ERROR_STRING(coded, "Read %s fatal", "./from.txt");
+    std::string wire;
+    ymh::wire::encoder encoder;
+    encoder.encode(assigned, wire);
+    encoder.encode(coded, wire);
+    ymh::wire::decoder decoder;
+    char const* first = wire.data();
+    for (auto const* sent : { &assigned, &coded })
+    {
+        std::vector<ymh::wire::frame> decoded;
+        std::ostringstream ostrm;
+        if (!decoder.decode(first, wire.data() + wire.size(), decoded))
+        {
+            return fail("error chain isn't decoded");
+        }
+        ymh::wire::dump_backtrace(decoded, ostrm);
+        if (ostrm.str() != sent->dump_backtrace())
+        {
+            return fail("decoded error chain prints differently");
+        }
+    }
+
     ymh::error_t e;
     if (!Foo(e))
     {
@@ -2,6 +2,13 @@
 
 #include "una.hpp"
 
+static int fail(char const* what)
+{
+    puts("Error: ");
+    puts(what);
+    return 1;
+}
+
 int main()
 {
     /*
@@ -11,12 +18,170 @@ int main()
     */
     try
     {
-        auto raw = u8"中華人民共和國，福建省廈門市，軟件園二期";
+        // char8_t since C++20.
+        auto raw = reinterpret_cast<char const*>(
+            u8"中華人民共和國，福建省廈門市，軟件園二期");
         auto uni = ymh::UTF8ToUnicode(raw);
         auto ansi = ymh::UnicodeToANSI(uni);
         auto res = ansi;
         puts("Result: ");
         puts(res.c_str());
+
+        // each invalid sequence is counted once, up to where the policy
+        // stops.
+        std::string const dirty = "a\xff" "b\xfe" "c";
+        std::size_t invalid = 0;
+        if (ymh::decode<ymh::codepage::cp_utf8, ymh::bom::nobomb
+                        , ymh::policy::replace>(dirty, invalid)
+                != L"a\xFFFD" L"b\xFFFD" L"c" || invalid != 2)
+        {
+            return fail("replaced sequences aren't counted");
+        }
+        invalid = 0;
+        if (ymh::decode<ymh::codepage::cp_utf8, ymh::bom::nobomb
+                        , ymh::policy::skip>(dirty, invalid) != L"abc"
+            || invalid != 2)
+        {
+            return fail("skipped sequences aren't counted");
+        }
+        invalid = 0;
+        if (ymh::decode<ymh::codepage::cp_utf8, ymh::bom::nobomb
+                        , ymh::policy::stop>(dirty, invalid) != L"a"
+            || invalid != 1)
+        {
+            return fail("stop isn't counted once");
+        }
+        invalid = 0;
+        if (ymh::codec(ymh::codepage::cp_latin1, ymh::bom::nobomb
+                       , ymh::policy::replace, "?").encode(
+                std::wstring(L"a\x4E2D" L"b\x4E2D"), invalid) != "a?b?"
+            || invalid != 2)
+        {
+            return fail("unencodable characters aren't counted");
+        }
+
+        // line endings become LF and a leading U+FEFF goes.
+        if (ymh::decode<ymh::codepage::cp_gb18030, ymh::bom::nobomb
+                        , ymh::policy::strict, ymh::normalize::all>(
+                std::string("\x84\x31\x95\x33" "a\r\n\r\rb\r"))
+            != L"a\n\n\nb\n")
+        {
+            return fail("GB18030 text isn't normalized");
+        }
+        ymh::save_file_data("test_una_nl.txt"
+                            , std::string("\xEF\xBB\xBF" "a\r\nb\r"));
+        auto const normalized = ymh::file_text<ymh::codepage::cp_utf8
+            , ymh::bom::nobomb, ymh::normalize::all>("test_una_nl.txt");
+        std::remove("test_una_nl.txt");
+        if (normalized != "a\nb\n")
+        {
+            return fail("file text isn't normalized");
+        }
+
+        // accented Latin-1 at the end isn't a truncated UTF-8 sequence.
+        if (ymh::hint_codepage("caf\xe9") != ymh::codepage::cp_latin1)
+        {
+            return fail("\"caf\\xe9\" isn't hinted as Latin-1");
+        }
+
+        // bom and text only, no padding after them.
+        if (ymh::encode<ymh::codepage::cp_gb18030, ymh::bom::bomb>(
+                std::wstring(L"ab")) != "\x84\x31\x95\x33" "ab")
+        {
+            return fail("GB18030 \"ab\" with bom isn't 6 bytes");
+        }
+
+        // needle bytes inside a character aren't a match.
+        std::string const gb = "\x81\x61" "a" "\xc4\xe3\xba\xc3\xe3\xba";
+        if (ymh::search<ymh::codepage::cp_gb18030>(gb, L"a") != 2
+            || ymh::search<ymh::codepage::cp_gb18030>(gb
+                , ymh::decode<ymh::codepage::cp_gb18030>(
+                    std::string("\xe3\xba"))) != 7)
+        {
+            return fail("GB18030 search matches across characters");
+        }
+
+        // characters split across small blocks come back the same.
+        std::wstring report;
+        for (int i = 0; i != 100; ++i)
+        {
+            report += L"ab\x4E2D\x0100";
+        }
+        std::stringbuf bytes;
+        {
+            ymh::transcoding_streambuf<ymh::codepage::cp_gb18030
+                                       , ymh::bom::bomb> buf(&bytes
+                , ymh::policy::strict, std::string(), 16);
+            std::wostream out(&buf);
+            out << report;
+        }
+        ymh::transcoding_streambuf<ymh::codepage::cp_gb18030
+                                   , ymh::bom::bomb> buf(&bytes
+            , ymh::policy::strict, std::string(), 16);
+        std::wistream in(&buf);
+        if (bytes.str().compare(0, 4, "\x84\x31\x95\x33") != 0
+            || std::wstring(std::istreambuf_iterator<wchar_t>(in)
+                            , std::istreambuf_iterator<wchar_t>()) != report)
+        {
+            return fail("stream buffer round trip differs");
+        }
+
+        // index saved and loaded finds the same offsets, a corrupt one is
+        // rejected rather than walked past the end of text.
+        std::string const text = ymh::encode<ymh::codepage::cp_utf8>(
+            std::wstring(100, L'\x4E2D') + std::wstring(100, L'a'));
+        auto const idx = ymh::codepoint_index<ymh::codepage::cp_utf8>(text
+                                                                     , 16);
+        std::stringstream saved;
+        idx.save(saved);
+        ymh::basic_codepoint_index<ymh::codepage::cp_utf8> loaded;
+        loaded.load(saved, text.size());
+        if (loaded.offset(text.data(), 150) != 350)
+        {
+            return fail("codepoint index isn't the same after load");
+        }
+        std::string bad = saved.str();
+        bad[6 * 8 + 8 + 4] = '\x01';  // second offset, out of text
+        try
+        {
+            std::istringstream istrm(bad);
+            loaded.load(istrm, text.size());
+            return fail("corrupt codepoint index is loaded");
+        }
+        catch (std::system_error const& e)
+        {
+            if (e.code() != std::errc::invalid_argument)
+            {
+                throw;
+            }
+        }
+
+        // user-defined area of GB18030 measures as its UTF-8 text.
+        std::string const user_defined = "\xaa\xa1\xa6\xd9";
+        if (ymh::display_width<ymh::codepage::cp_gb18030>(user_defined)
+            != ymh::display_width<ymh::codepage::cp_utf8>(
+                ymh::convert<ymh::codepage::cp_gb18030
+                             , ymh::codepage::cp_utf8>(user_defined)))
+        {
+            return fail("GB18030 and UTF-8 widths differ");
+        }
+
+#if defined(__cpp_impl_coroutine)
+        // Latin-1 after an ascii head longer than a chunk.
+        std::string const head_tail = std::string(70000, 'x') + "caf\xe9";
+        ymh::save_file_data("test_una_l1.txt", head_tail);
+        ymh::pipeline::executor io(1), cpu(1);
+        ymh::pipeline::sync_wait(
+            ymh::pipeline::transcode_file<ymh::codepage::cp_utf8>(
+                io, cpu, "test_una_l1.txt", "test_una_l1.utf8.txt"));
+        auto const transcoded = ymh::file_data("test_una_l1.utf8.txt");
+        std::remove("test_una_l1.txt");
+        std::remove("test_una_l1.utf8.txt");
+        if (transcoded != std::string(70000, 'x') + "caf\xc3\xa9")
+        {
+            return fail("ascii head and Latin-1 tail isn't transcoded");
+        }
+#endif  // __cpp_impl_coroutine
     }
     catch (std::exception const& e)
     {
@@ -38,6 +38,92 @@
  *     std::wstring wtext = read_file_text(L"demo.txt");
  *     save_file_text<codepage::cp_utf8, bom::bomb>("demo.txt", "bingo");
  *
+ *     // CRLF and CR to LF while decoding, strip leading U+FEFF.
+ *     text = file_text<codepage::cp_utf8, bom::nobomb
+ *                      , normalize::all>("demo.txt");
+ *
+ * (5) Invalid Sequence Policy
+ *
+ *     std::size_t invalid = 0;  // number of substitutions
+ *     wtext = decode<codepage::cp_utf8, bom::nobomb, policy::replace>(
+ *                 dirty, invalid);
+ *     text = codec(codepage::cp_gb2312, bom::nobomb
+ *                  , policy::replace, "?").encode(wtext, invalid);
+ *
+ * (6) Conversion Statistics (define YMH_UNA_WITH_STATS)
+ *
+ *     std::vector<stats::record> records = stats::snapshot();
+ *     stats::dump(std::cout);
+ *
+ * (7) Conversion Cache (define YMH_UNA_WITH_CACHE)
+ *
+ *     std::shared_ptr<std::wstring const> host
+ *         = cache::decode<codepage::cp_utf8>(field);
+ *     cache::counters c = cache::snapshot();  // hits, misses, ...
+ *
+ * (8) Codepoint View
+ *
+ *     for (char32_t c : codepoints<codepage::cp_gb18030>(bytes))
+ *     {
+ *     }
+ *
+ * (9) Codepoint Index
+ *
+ *     auto idx = codepoint_index<codepage::cp_utf8>(text);
+ *     wtext = decode_range(text, idx, 1000000, 80);
+ *
+ * (10) Search Encoded Text
+ *
+ *     std::size_t pos = search<codepage::cp_gb18030>(bytes, L"needle");
+ *
+ * (11) Compile-time Literal (C++14)
+ *
+ *     static constexpr auto title = literal<wchar_t>(u8"wide string");
+ *
+ * (12) Codec Backends
+ *
+ *     backend::prefer(codepage::cp_utf8, "native");
+ *     backend::calibrate();  // prefer the fastest one per codepage
+ *
+ * (13) Lookup Tables (define YMH_UNA_WITH_TABLES, iconv only)
+ *
+ *     tables::set_directory("/var/cache/myapp");  // probed once, then mapped
+ *     wtext = decode<codepage::cp_gb2312>(text);
+ *
+ * (14) Latin-1
+ *
+ *     text = convert<codepage::cp_latin1, codepage::cp_utf8>(legacy);
+ *
+ * (15) Detection Cache (define YMH_UNA_WITH_DETECTION_CACHE, POSIX only)
+ *
+ *     text = file_text<codepage::cp_utf8>("demo.txt");  // detected once
+ *
+ * (16) Streaming Validation
+ *
+ *     utf8_validator v;
+ *     v.feed(buf, n);  // as often as needed
+ *     ok = v.finish();
+ *
+ * (17) Transcoding Stream Buffer
+ *
+ *     transcoding_streambuf<codepage::cp_gb18030> buf(file.rdbuf());
+ *     std::wostream out(&buf);  // or std::wistream to read
+ *
+ * (18) Coroutine Pipeline (C++20)
+ *
+ *     pipeline::executor io(4), cpu(2);
+ *     pipeline::sync_wait(pipeline::transcode_file<codepage::cp_gb18030>(
+ *         io, cpu, "demo.txt", "demo.gb18030.txt"));
+ *
+ * (19) Display Width
+ *
+ *     columns = display_width<codepage::cp_utf8>(text);  // CJK counts 2
+ *
+ * (20) Progress And Cancellation
+ *
+ *     progress::scope watch(on_report, 64 * 1024 * 1024, token);
+ *     auto wtext = decode(file_text("huge.log"));  // token.cancel() stops it
+ *
  * [Usage]
  *
  *     using namespace ymh;
@@ -58,16 +144,33 @@
 
 #include <cmath>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <fstream>
 #include <functional>
+#include <iomanip>
+#include <iterator>
 #include <limits>
+#include <locale>
 #include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
 #include <string>
 #include <system_error>
 #include <type_traits>
 #include <utility>
+#include <vector>
+
+#if defined(YMH_UNA_WITH_CACHE)
+#   include <list>
+#   include <unordered_map>
+#endif  // YMH_UNA_WITH_CACHE
 
 // For Windows
 #if defined(_WIN32) || defined(_MSC_VER)
@@ -98,21 +201,73 @@
 #   include <iconv.h>
 #endif  // YMH_UNA_WITH_ICONV
 
+// Files mapped into memory.
+#if (defined(YMH_UNA_WITH_TABLES) && defined(YMH_UNA_WITH_ICONV)) \
+    || (defined(YMH_UNA_WITH_DETECTION_CACHE) && !defined(_WIN32))
+#   include <cctype>
+#   include <cerrno>
+#   include <cstdio>
+#   include <fcntl.h>
+#   include <sys/file.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif  // YMH_UNA_WITH_TABLES || YMH_UNA_WITH_DETECTION_CACHE
+
+// SSE2 is baseline of x86-64.
+#if defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   if !defined(YMH_UNA_WITH_SSE2) && !defined(YMH_UNA_WITHOUT_SSE2)
+#       define YMH_UNA_WITH_SSE2 1
+#   endif  // !YMH_UNA_WITH_SSE2 && !YMH_UNA_WITHOUT_SSE2
+#endif  // __SSE2__ || _M_X64 || _M_IX86_FP >= 2
+
+#if defined(YMH_UNA_WITH_SSE2)
+#   include <emmintrin.h>
+#endif  // YMH_UNA_WITH_SSE2
+
+// AVX2 if the compiler targets it (-mavx2, /arch:AVX2).
+#if defined(__AVX2__) && defined(YMH_UNA_WITH_SSE2)
+#   if !defined(YMH_UNA_WITH_AVX2) && !defined(YMH_UNA_WITHOUT_AVX2)
+#       define YMH_UNA_WITH_AVX2 1
+#   endif  // !YMH_UNA_WITH_AVX2 && !YMH_UNA_WITHOUT_AVX2
+#endif  // __AVX2__ && YMH_UNA_WITH_SSE2
+
+#if defined(YMH_UNA_WITH_AVX2)
+#   include <immintrin.h>
+#endif  // YMH_UNA_WITH_AVX2
+
+// Coroutine pipeline, C++20.
+#if defined(__cpp_impl_coroutine)
+#   include <condition_variable>
+#   include <coroutine>
+#   include <deque>
+#   include <exception>
+#   include <optional>
+#   include <thread>
+#endif  // __cpp_impl_coroutine
+
 #if defined(_MSC_VER)
 #   pragma warning(disable: 4018)
 #endif
 
 #define DEFAULT_CP ymh::una::codepage::cp_default
 #define DEFAULT_BOM ymh::una::bom::nobomb
+#define DEFAULT_POLICY ymh::una::policy::strict
+#define DEFAULT_NORMALIZE ymh::una::normalize::none
 
 #if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
 #   define CONSTEXPR constexpr
 #   define CP_DEFAULT_TEMPLATE_ARG = DEFAULT_CP
 #   define BOM_DEFAULT_TEMPLATE_ARG = DEFAULT_BOM
+#   define POLICY_DEFAULT_TEMPLATE_ARG = DEFAULT_POLICY
+#   define NORMALIZE_DEFAULT_TEMPLATE_ARG = DEFAULT_NORMALIZE
 #else
 #   define CONSTEXPR const
 #   define CP_DEFAULT_TEMPLATE_ARG
 #   define BOM_DEFAULT_TEMPLATE_ARG
+#   define POLICY_DEFAULT_TEMPLATE_ARG
+#   define NORMALIZE_DEFAULT_TEMPLATE_ARG
 #endif
 
 namespace ymh
@@ -128,6 +283,7 @@ enum type {
     , cp_gb18030
     , cp_ucs2_le
     , cp_ucs2_be
+    , cp_latin1     // ISO-8859-1
 };
 }  // namespace codepage::type
 
@@ -139,6 +295,26 @@ enum type {
 };
 }  // namespace bom
 
+namespace policy  // Invalid Sequence Handling
+{
+enum type {
+    strict      // throw std::system_error (illegal byte sequence)
+    , replace   // substitute U+FFFD, or replacement bytes when encoding
+    , skip      // drop invalid sequences
+    , stop      // truncate at the first invalid sequence
+};
+}  // namespace policy
+
+namespace normalize  // Decoded Text Normalization
+{
+enum type {
+    none        = 0x00
+    , eol       = 0x01  // CRLF and CR to LF
+    , zwnbsp    = 0x02  // strip leading U+FEFF
+    , all       = eol | zwnbsp
+};
+}  // namespace normalize
+
 namespace detail
 {
 
@@ -161,9 +337,9 @@ CONSTEXPR unsigned char g_scsu_bom[]       = { 0x0E, 0xFE, 0xFF };
 CONSTEXPR unsigned char g_bocu1_bom[]      = { 0xFB, 0xEE, 0x28 };
 
 // <length, chars>
-inline std::pair<int, unsigned char const*> get_bom(codepage::type cp)
+inline std::pair<std::size_t, unsigned char const*> get_bom(codepage::type cp)
 {
-    int size = 0;
+    std::size_t size = 0;
     unsigned char const* chars = nullptr;
 
     using namespace codepage;
@@ -218,1536 +394,8883 @@ struct default_del
 typedef std::unique_ptr<char[], default_del<char> > char_ptr;
 typedef std::unique_ptr<wchar_t[], default_del<wchar_t> > wchar_ptr;
 
-} // namespace detail
-
-/*****************************************************************************/
-/* Abstract Platform Implement. */
-
-namespace detail
-{
-
-class codec_impl
+// Normalize text in place chunk by chunk, a CR at the end of one chunk
+// is remembered to join the LF at the beginning of next chunk.
+template <class CharT>
+class basic_newline_filter
 {
 public:
-    typedef std::function<char* (int)> alloc4en_t;
-    typedef std::function<wchar_t* (int)> alloc4de_t;
-
-public:
-    codec_impl(codepage::type cp, bom::type bo) : cp_(cp), bom_(bo)
+    explicit basic_newline_filter(normalize::type nl) : nl_(nl)
     {}
 
-    virtual ~codec_impl()
-    {}
+    explicit operator bool() const
+    {
+        return nl_ != normalize::none;
+    }
 
-    static std::shared_ptr<codec_impl> create_instance(codepage::type cp
-                                                       , bom::type bo);
+    // return new end of [first, last).
+    CharT* operator()(CharT* first, CharT* last)
+    {
+        if (first == last || nl_ == normalize::none)
+        {
+            return last;
+        }
 
-    virtual void encode_impl(wchar_t const* wstr, int in_size, int& out_size
-                             , alloc4en_t const& allocator) const = 0;
+        CharT* in = first;
+        if (leading_)
+        {
+            leading_ = false;
+            if ((nl_ & normalize::zwnbsp)
+                && static_cast<std::uint32_t>(*in) == 0xFEFF)
+            {
+                ++in;
+            }
+        }
 
-    virtual void decode_impl(char const* bytes, int in_size, int& out_size
-                             , alloc4de_t const& allocator) const = 0;
+        if (!(nl_ & normalize::eol))
+        {
+            return std::copy(in, last, first);
+        }
 
-protected:
-    std::pair<int, unsigned char const*> get_bom() const
-    {
-        if (bom_ == bom::nobomb)
+        CharT* out = first;
+        while (in != last)
         {
-            int size = 0;
-            unsigned char const* chars = nullptr;
-            return std::make_pair(size, chars);
+            if (cr_)
+            {
+                cr_ = false;
+                if (*in == CharT('\n'))
+                {
+                    ++in;
+                    continue;
+                }
+            }
+
+            auto const cr = std::find(in, last, CharT('\r'));
+            out = (out == in) ? cr : std::copy(in, cr, out);
+            if (cr == last)
+            {
+                break;
+            }
+            *out++ = CharT('\n');
+            in = cr + 1;
+            cr_ = true;
         }
-        return detail::get_bom(this->cp_);
+        return out;
     }
 
-protected:
-    codepage::type cp_;
-    bom::type bom_;
+private:
+    normalize::type nl_;
+    bool leading_ = true;
+    bool cr_ = false;
 };
 
-}  // namespace detail
+// input bytes per iconv call, output is normalized while it is hot.
+CONSTEXPR int g_chunk_size = 64 * 1024;
+
+// $XDG_CACHE_HOME or $HOME/.cache, empty if neither.
+inline std::string user_cache_directory()
+{
+    auto const cache = std::getenv("XDG_CACHE_HOME");
+    auto const home = std::getenv("HOME");
+    if (cache && *cache)
+    {
+        return cache;
+    }
+    else if (home && *home)
+    {
+        return std::string(home) + "/.cache";
+    }
+    return std::string();
+}
+
+} // namespace detail
 
 /*****************************************************************************/
-/* Codec Bridge Interface. */
+/* Conversion Statistics. */
 
-class codec
+//
+// Define YMH_UNA_WITH_STATS before include una.hpp to record counters per
+// codepage pair, it costs nothing if undefined.
+//
+// Counters live in per-thread blocks and are merged on read.
+//
+namespace stats
 {
-public:
-    typedef detail::char_ptr char_ptr;
-    typedef detail::wchar_ptr wchar_ptr;
 
-    // Deprecated: Use ymh::bom::xx instead of ymh::codec::xx
-    static CONSTEXPR auto bomb   = bom::bomb;
-    static CONSTEXPR auto nobomb = bom::nobomb;
+// wchar_t side of codepage pair.
+CONSTEXPR int wide = -1;
+
+enum counter {
+    calls
+    , bytes_in
+    , bytes_out
+    , nanoseconds
+    , iconv_opens
+    , regrowths     // buffer regrowth (E2BIG / partial retries)
+    , exceptions
+    , counter_count
+};
 
-    // Deprecated: Use ymh::codepage:xx instead of ymh::codec::xx
-    static CONSTEXPR auto cp_default = codepage::cp_default;
-    static CONSTEXPR auto cp_utf8    = codepage::cp_utf8;
-    static CONSTEXPR auto cp_gb2312  = codepage::cp_gb2312;
-    static CONSTEXPR auto cp_gb18030 = codepage::cp_gb18030;
-    static CONSTEXPR auto cp_ucs2_le = codepage::cp_ucs2_le;
-    static CONSTEXPR auto cp_ucs2_be = codepage::cp_ucs2_be;
+struct record
+{
+    int from;  // codepage::type or stats::wide
+    int to;
+    std::uint64_t value[counter_count];
+};
 
-public:
-    explicit codec(codepage::type cp = codepage::cp_default
-                   , bom::type bo = bom::nobomb)
-        : cp_(cp), bom_(bo)
-    {}
+}  // namespace stats
 
-    virtual ~codec()
-    {}
+namespace detail
+{
 
-    char_ptr encode(wchar_t const* wstr, int in_size, int& out_size) const
+inline char const* codepage_name(int cp)
+{
+    using namespace codepage;
+    switch (cp)
     {
-        char_ptr out_ptr;
-        int out_num = 0;
+    case stats::wide:   return "wchar_t";
+    case cp_default:    return "default";
+    case cp_utf8:       return "UTF-8";
+    case cp_gb2312:     return "GB2312";
+    case cp_gb18030:    return "GB18030";
+    case cp_ucs2_le:    return "UCS-2LE";
+    case cp_ucs2_be:    return "UCS-2BE";
+    case cp_latin1:     return "ISO-8859-1";
+    }
+    return "unknown";
+}
 
-        auto alloc = [&out_ptr, &out_num](int n) -> char*
-        {
-            out_num = n;
-            char* cp = nullptr;
+#if defined(YMH_UNA_WITH_STATS)
 
-            if (out_ptr)
-            {
-                cp = (char*)::realloc(out_ptr.release()
-                                      , out_num * sizeof(char));
-            }
-            else
-            {
-                cp = (char*)::calloc(out_num, sizeof(char));
-            }
+class stats_registry
+{
+public:
+    // one slot for stats::wide and the codepages.
+    static CONSTEXPR int cp_slots = 16;
+    static CONSTEXPR int pair_slots = cp_slots * cp_slots;
 
-            if (!cp)
+    struct block
+    {
+        block()
+        {
+            for (auto& p : value)
             {
-                throw std::system_error(
-                    std::make_error_code(
-                        std::errc::not_enough_memory)
-                    , "Allocate memory for encode");
+                for (auto& v : p)
+                {
+                    v.store(0, std::memory_order_relaxed);
+                }
             }
+        }
 
-            char_ptr p(cp);
-            out_ptr.swap(p);
-
-            return out_ptr.get();
-        };
-        
-        encode_impl(wstr, in_size, out_size, alloc);
-        if (out_size < out_num)
+        // single writer (the owner thread), so plain load-store is enough.
+        void add(int pair, stats::counter c, std::uint64_t n)
         {
-            out_ptr[out_size] = '\0';
+            auto& v = value[pair][c];
+            v.store(v.load(std::memory_order_relaxed) + n
+                    , std::memory_order_relaxed);
         }
-        return std::move(out_ptr);
+
+        std::atomic<std::uint64_t> value[pair_slots][stats::counter_count];
+    };
+
+public:
+    static stats_registry& instance()
+    {
+        static stats_registry registry;
+        return registry;
     }
 
-    std::string encode(std::wstring const& wstr) const
+    static int pair_index(int from, int to)
+    {
+        return (from + 1) * cp_slots + (to + 1);
+    }
+
+    void attach(block* b)
     {
-        auto const in_size = wstr.size();
-        if ((std::numeric_limits<int>::max)() < in_size)
+        std::lock_guard<std::mutex> lock(mtx_);
+        blocks_.push_back(b);
+    }
+
+    // merge counters of exited thread.
+    void detach(block* b)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (int p = 0; p != pair_slots; ++p)
         {
-            throw std::system_error(std::make_error_code
-                                    (std::errc::result_out_of_range)
-                                    , "Input character's size is out of range");
+            for (int c = 0; c != stats::counter_count; ++c)
+            {
+                retired_[p][c] += b->value[p][c].load(
+                    std::memory_order_relaxed);
+            }
         }
-
-        int out_size = 0;
-        std::string out;
-        encode_impl(wstr.data(), static_cast<int>(in_size), out_size
-                    , [&out](int n) -> char*
-                    {
-                        out.resize(n);
-                        return const_cast<char*>(out.data());
-                    });
-        out.resize(out_size);
-        return out;
+        blocks_.erase(std::remove(blocks_.begin(), blocks_.end(), b)
+                      , blocks_.end());
     }
 
-    wchar_ptr decode(char const* bytes, int in_size, int& out_size) const
+    std::vector<stats::record> snapshot()
     {
-        wchar_ptr out_ptr;
-        int out_num = 0;
+        std::lock_guard<std::mutex> lock(mtx_);
 
-        auto alloc = [&out_ptr, &out_num](int n) -> wchar_t*
+        std::vector<stats::record> records;
+        for (int p = 0; p != pair_slots; ++p)
         {
-            out_num = n;
-            wchar_t* cp = nullptr;
+            stats::record r;
+            r.from = p / cp_slots - 1;
+            r.to = p % cp_slots - 1;
 
-            if (out_ptr)
-            {
-                cp = (wchar_t*)::realloc(
-                    out_ptr.release()
-                    , out_num * sizeof(wchar_t));
-            }
-            else
+            bool used = false;
+            for (int c = 0; c != stats::counter_count; ++c)
             {
-                cp = (wchar_t*)::calloc(out_num, sizeof(wchar_t));
+                auto v = sum(p, c);
+                r.value[c] = v - baseline_[p][c];
+                used = used || r.value[c];
             }
-
-            if (!cp)
+            if (used)
             {
-                throw std::system_error(
-                    std::make_error_code(
-                        std::errc::not_enough_memory)
-                    , "Allocate memory for decode");
+                records.push_back(r);
             }
-
-            wchar_ptr p(cp);
-            out_ptr.swap(p);
-
-            return out_ptr.get();
-        };
-
-        decode_impl(bytes, in_size, out_size, alloc);
-        if (out_size < out_num)
-        {
-            out_ptr.get()[out_size] = L'\0';
         }
-        return std::move(out_ptr);
+        return records;
     }
 
-    std::wstring decode(std::string const& bytes) const
+    // counters are written without lock, so reset moves the baseline.
+    void reset()
     {
-        auto const in_size = bytes.size();
-        if ((std::numeric_limits<int>::max)() < in_size)
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (int p = 0; p != pair_slots; ++p)
         {
-            throw std::system_error(std::make_error_code
-                                    (std::errc::result_out_of_range)
-                                    , "Input character's size is out of range");
+            for (int c = 0; c != stats::counter_count; ++c)
+            {
+                baseline_[p][c] = sum(p, c);
+            }
         }
-
-        std::wstring out;
-        int out_size = 0;
-        decode_impl(bytes.data(), static_cast<int>(in_size), out_size
-                    , [&out](int n) -> wchar_t*
-                    {
-                        out.resize(n);
-                        return const_cast<wchar_t*>(out.data());
-                    });
-        out.resize(out_size);
-        return out;
     }
 
-public:
-    char_ptr operator()(wchar_t const* wstr, int in_size, int& out_size) const
+private:
+    stats_registry()
     {
-        return encode(wstr, in_size, out_size);
+        std::fill(&retired_[0][0]
+                  , &retired_[0][0] + pair_slots * stats::counter_count, 0);
+        std::fill(&baseline_[0][0]
+                  , &baseline_[0][0] + pair_slots * stats::counter_count, 0);
     }
 
-    std::string operator()(std::wstring const& wstr) const
+    std::uint64_t sum(int p, int c) const
     {
-        return encode(wstr);
+        auto v = retired_[p][c];
+        for (auto b : blocks_)
+        {
+            v += b->value[p][c].load(std::memory_order_relaxed);
+        }
+        return v;
     }
 
-    wchar_ptr operator()(char const* bytes, int in_size, int& out_size) const
+private:
+    std::mutex mtx_;
+    std::vector<block*> blocks_;
+    std::uint64_t retired_[pair_slots][stats::counter_count];
+    std::uint64_t baseline_[pair_slots][stats::counter_count];
+};
+
+struct thread_stats
+{
+    thread_stats()
     {
-        return decode(bytes, in_size, out_size);
+        stats_registry::instance().attach(&block_);
     }
 
-    std::wstring operator()(std::string const& bytes) const
+    ~thread_stats()
     {
-        return decode(bytes);
+        stats_registry::instance().detach(&block_);
     }
 
-private:
-    // allocator: char* allocator(int size);
-    template <class AllocatorT>
-    void encode_impl(wchar_t const* wstr, int in_size
-                     , int& out_size, AllocatorT const& allocator) const
+    stats_registry::block block_;
+};
+
+inline stats_registry::block& local_stats()
+{
+    static thread_local thread_stats ts;
+    return ts.block_;
+}
+
+inline void stats_add(int from, int to, stats::counter c, std::uint64_t n = 1)
+{
+    local_stats().add(stats_registry::pair_index(from, to), c, n);
+}
+
+// record calls, bytes and time of one conversion, or exception if
+// done() is never reached.
+class stats_scope
+{
+public:
+    stats_scope(int from, int to, std::uint64_t in_bytes)
+        : from_(from), to_(to), in_bytes_(in_bytes)
+        , start_(std::chrono::steady_clock::now())
+    {}
+
+    ~stats_scope()
     {
-        auto ci = detail::codec_impl::create_instance(cp_, bom_);
-        return ci->encode_impl(wstr, in_size, out_size, allocator);
+        if (!done_)
+        {
+            stats_add(from_, to_, stats::calls);
+            stats_add(from_, to_, stats::exceptions);
+        }
     }
 
-    // allocator: wchar_t* allocator(int size);
-    template <class AllocatorT>
-    void decode_impl(char const* bytes, int in_size
-                     , int& out_size, AllocatorT const& allocator) const
+    void done(std::uint64_t out_bytes)
     {
-        auto ci = detail::codec_impl::create_instance(cp_, bom_);
-        return ci->decode_impl(bytes, in_size, out_size, allocator);
+        auto const elapsed = std::chrono::steady_clock::now() - start_;
+        stats_add(from_, to_, stats::calls);
+        stats_add(from_, to_, stats::bytes_in, in_bytes_);
+        stats_add(from_, to_, stats::bytes_out, out_bytes);
+        stats_add(from_, to_, stats::nanoseconds
+                  , std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      elapsed).count());
+        done_ = true;
     }
 
 private:
-    codepage::type cp_;
-    bom::type bom_;
+    int from_;
+    int to_;
+    std::uint64_t in_bytes_;
+    std::chrono::steady_clock::time_point start_;
+    bool done_ = false;
 };
 
-/*****************************************************************************/
-/* Windows Implement. */
+#else
 
-#if defined(_WIN32) || defined(_MSC_VER)
+inline void stats_add(int, int, stats::counter, std::uint64_t = 1)
+{}
 
-//
-// WideCharToMultiByte、MultiByteToWideChar Implement.
-//
-namespace detail
+class stats_scope
 {
-namespace ucs2_le
+public:
+    stats_scope(int, int, std::uint64_t)
+    {}
+
+    void done(std::uint64_t)
+    {}
+};
+
+#endif  // YMH_UNA_WITH_STATS
+
+}  // namespace detail
+
+namespace stats
 {
 
-inline int WideCharToMultiByte(wchar_t const* wstr, int in_size
-                               , char* out, int out_size)
+// counters since start or last reset(), empty if YMH_UNA_WITH_STATS
+// is undefined.
+inline std::vector<record> snapshot()
 {
-    auto const in_byte_size = in_size * static_cast<int>
-    (sizeof(wchar_t) / sizeof(char));
-    if (out_size == 0)
-    {
-        return in_byte_size;
-    }
+#if defined(YMH_UNA_WITH_STATS)
+    return detail::stats_registry::instance().snapshot();
+#else
+    return std::vector<record>();
+#endif  // YMH_UNA_WITH_STATS
+}
 
-    auto in = (unsigned char const*)wstr;
-    for (int i = 0
-         ; i != (in_byte_size < out_size ? in_byte_size : out_size)
-         ; ++i)
-    {
-        *(out + i) = *(in + i);
-    }
-    return out_size;
+inline void reset()
+{
+#if defined(YMH_UNA_WITH_STATS)
+    detail::stats_registry::instance().reset();
+#endif  // YMH_UNA_WITH_STATS
 }
 
-inline int MultiByteToWideChar(char const* bytes, int in_size
-                               , wchar_t* out, int out_size)
+inline void dump(std::ostream& ostrm)
 {
-    auto const out_wchar_size = in_size / static_cast<int>
-    (sizeof(wchar_t) / sizeof(char));
-    if (out_size == 0)
-    {
-        return out_wchar_size;
-    }
+    auto const records = snapshot();
 
-    auto p_out = (unsigned char*)out;
-    auto const out_byte_size = out_size * static_cast<int>
-    (sizeof(wchar_t) / sizeof(char));
-    for (int i = 0
-         ; i != (in_size < out_byte_size ? in_size : out_byte_size)
-         ; ++i)
+    // codepage columns fit the longest name, every column is followed by a
+    // space so that a wide value never runs into the next one.
+    std::size_t cp_width = 8;
+    for (auto const& r : records)
     {
-        *(p_out + i) = *(bytes + i);
+        cp_width = (std::max)(cp_width, std::strlen(
+            detail::codepage_name(r.from)));
+        cp_width = (std::max)(cp_width, std::strlen(
+            detail::codepage_name(r.to)));
     }
-    return out_size;
-}
-
-inline bool is_ucs2_le(char const* bytes, int in_size)
-{
-    if (in_size % 2)
-        // ucs2 byte size is even
+    auto const w = static_cast<int>(cp_width);
+
+    ostrm << std::left
+          << std::setw(w) << "FROM" << ' '
+          << std::setw(w) << "TO" << ' '
+          << std::setw(10) << "CALLS" << ' '
+          << std::setw(12) << "IN(B)" << ' '
+          << std::setw(12) << "OUT(B)" << ' '
+          << std::setw(12) << "TIME(us)" << ' '
+          << std::setw(8) << "OPENS" << ' '
+          << std::setw(8) << "REGROWS" << ' '
+          << "EXCEPTS\n";
+    for (auto const& r : records)
     {
-        --in_size;
+        auto const& v = r.value;
+        ostrm << std::left
+              << std::setw(w) << detail::codepage_name(r.from) << ' '
+              << std::setw(w) << detail::codepage_name(r.to) << ' '
+              << std::setw(10) << v[calls] << ' '
+              << std::setw(12) << v[bytes_in] << ' '
+              << std::setw(12) << v[bytes_out] << ' '
+              << std::setw(12) << v[nanoseconds] / 1000 << ' '
+              << std::setw(8) << v[iconv_opens] << ' '
+              << std::setw(8) << v[regrowths] << ' '
+              << v[exceptions] << '\n';
     }
-
-    return ::IsTextUnicode(reinterpret_cast<void const*>(bytes)
-                           , in_size, nullptr) ? true : false;
 }
 
-inline bool is_ucs2_le(std::string const& bytes)
+inline std::string dump()
 {
-    auto const in_size = bytes.size();
-    if ((std::numeric_limits<int>::max)() < in_size)
-    {
-        throw std::system_error(std::make_error_code
-                                (std::errc::result_out_of_range)
-                                , "Input character's size is out of range");
-    }
-
-    return is_ucs2_le(const_cast<char const*>(bytes.data())
-                      , static_cast<int>(in_size));
+    std::ostringstream ostrm;
+    dump(ostrm);
+    return ostrm.str();
 }
 
-} // namespace ucs2_le
+}  // namespace stats
 
-namespace ucs2_be
+/*****************************************************************************/
+/* Progress And Cancellation. */
+
+//
+// Long conversions report progress and can be cancelled by a scope on the
+// calling thread, codec and file functions called in the scope check it
+// between chunks (64 KiB) of input. A call counts the bytes of its input
+// once, e.g. file_text the file read, not the text it decodes.
+//
+//     progress::token cancel;  // cancel.cancel() from another thread
+//     progress::scope watch([](progress::report const& r)
+//                           {
+//                               std::cout << r.bytes / r.seconds() << "B/s\n";
+//                           }, 64 * 1024 * 1024, cancel);
+//     auto text = file_text<codepage::cp_utf8>("huge.log");
+//
+// Cancellation throws std::system_error (operation canceled).
+//
+namespace progress
 {
 
-inline int WideCharToMultiByte(wchar_t const* wstr, int in_size
-                               , char* out, int out_size)
+struct report
 {
-    auto const in_byte_size = in_size * static_cast<int>
-    (sizeof(wchar_t) / sizeof(char));
-    if (out_size == 0)
-    {
-        return in_byte_size;
-    }
+    std::uint64_t bytes;  // input consumed by calls since the scope
+    std::chrono::nanoseconds elapsed;
 
-    auto in = (unsigned char const*)wstr;
-    for (int i = 0
-         ; i != (in_byte_size < out_size ? in_byte_size : out_size)
-         ; ++i)
+    double seconds() const
     {
-        *(out + i) = *(in + ((i % 2 == 0) ? (i + 1) : (i - 1)));
+        return std::chrono::duration<double>(elapsed).count();
     }
-    return out_size;
-}
+};
 
-inline int MultiByteToWideChar(char const* bytes, int in_size
-                               , wchar_t* out, int out_size)
+typedef std::function<void (report const&)> callback;
+
+// cooperative cancellation, copies share the state.
+class token
 {
-    auto const out_wchar_size = in_size / static_cast<int>
-    (sizeof(wchar_t) / sizeof(char));
-    if (out_size == 0)
+public:
+    token()
+        : cancelled_(std::make_shared<std::atomic<bool>>(false))
+    {}
+
+    void cancel() const
     {
-        return out_wchar_size;
+        cancelled_->store(true, std::memory_order_relaxed);
     }
 
-    auto p_out = (unsigned char*)out;
-    auto const out_byte_size = out_size * static_cast<int>
-    (sizeof(wchar_t) / sizeof(char));
-    for (int i = 0
-         ; i != (in_size < out_byte_size ? in_size : out_byte_size)
-         ; ++i)
+    bool cancelled() const
     {
-        *(p_out + i) = *(bytes + ((i % 2 == 0) ? (i + 1) : (i - 1)));
+        return cancelled_->load(std::memory_order_relaxed);
     }
-    return out_size;
-}
 
-} // namespace ucs2_be
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+};
 
-inline int to_win_codepage(codepage::type cp)
+class scope;
+
+}  // namespace progress
+
+namespace detail
 {
-    using namespace codepage;
-    switch(cp)
-    {
-    case cp_default: return CP_ACP;
-    case cp_utf8:    return CP_UTF8;
-    case cp_gb2312:  return 936;
-    case cp_gb18030: return 54936;
-    case cp_ucs2_le: return 1200;
-    case cp_ucs2_be: return 1201;
-    }
-    return cp;
+
+// file functions read and write this size at a time.
+CONSTEXPR int g_io_chunk_size = 1024 * 1024;
+
+struct progress_state
+{
+    progress::callback notify;
+    progress::token cancel;
+    std::uint64_t every;
+    std::uint64_t bytes;
+    std::uint64_t next;
+    std::chrono::steady_clock::time_point start;
+    unsigned calls;  // progress_call depth
+    bool counted;    // a loop of the outermost call counted its input
+};
+
+inline progress_state*& current_progress()
+{
+    static thread_local progress_state* state = nullptr;
+    return state;
 }
 
-inline int WideCharToMultiByte(codepage::type cp
-                               , wchar_t const* wstr, int in_size
-                               , char* out, int out_size)
+// whether a loop over input counts its bytes, every loop does outside a
+// progress_call, only the first one inside.
+inline bool progress_counts()
 {
-    using namespace codepage;
-    switch (cp)
+    auto const s = current_progress();
+    if (!s || (s->calls && s->counted))
     {
-    case cp_ucs2_le:
-        return ucs2_le::WideCharToMultiByte(wstr, in_size, out, out_size);
-    case cp_ucs2_be:
-        return ucs2_be::WideCharToMultiByte(wstr, in_size, out, out_size);
-    default:
-        break;
+        return false;
     }
-    return ::WideCharToMultiByte(to_win_codepage(cp), 0
-                                 , wstr, in_size
-                                 , out, out_size
-                                 , nullptr, nullptr);
+    s->counted = s->calls != 0;
+    return true;
 }
 
-inline int MultiByteToWideChar(codepage::type cp
-                               , char const* bytes, int in_size
-                               , wchar_t* out, int out_size)
+// bytes processed since last call, cheap if no scope. Uncounted loops
+// still check cancellation.
+inline void progress_step(std::uint64_t bytes, bool count = true)
 {
-    using namespace codepage;
-    switch (cp)
+    auto const s = current_progress();
+    if (!s)
     {
-    case cp_ucs2_le:
-        return ucs2_le::MultiByteToWideChar(bytes, in_size, out, out_size);
-    case cp_ucs2_be:
-        return ucs2_be::MultiByteToWideChar(bytes, in_size, out, out_size);
-    default:
-        break;
+        return;
+    }
+    if (s->cancel.cancelled())
+    {
+        throw std::system_error(
+            std::make_error_code(std::errc::operation_canceled)
+            , "conversion");
+    }
+    if (!count)
+    {
+        return;
+    }
+
+    s->bytes += bytes;
+    if (s->notify && s->bytes >= s->next)
+    {
+        s->next = s->bytes + s->every;
+        progress::report r;
+        r.bytes = s->bytes;
+        r.elapsed = std::chrono::steady_clock::now() - s->start;
+        s->notify(r);
     }
-    return ::MultiByteToWideChar(to_win_codepage(cp), 0
-                                 , bytes, in_size
-                                 , out, out_size);
 }
 
-//
-// Windows Codec Implement.
-//
-class win_impl : public codec_impl
+// progress_step every g_chunk_size units of loops over input.
+class progress_meter
 {
 public:
-    win_impl(codepage::type cp, bom::type bo)
-        : codec_impl(cp, bo)
+    explicit progress_meter(std::size_t unit_size = 1)
+        : unit_size_(unit_size), done_(0), mark_(g_chunk_size)
+        , count_(progress_counts())
     {}
 
-    virtual void encode_impl(wchar_t const* wstr, int in_size, int& out_size
-                             , codec_impl::alloc4en_t const& allocator) const
+    void operator()(std::size_t position)
     {
-        auto const bom_size = this->get_bom().first;
-        auto const bom_chars = this->get_bom().second;
-
-        char* out = nullptr;
-        for (out_size = 0; !out; out_size += bom_size)
+        if (position >= mark_)
         {
-            if (!in_size)
-                // fill BOM if in_size == 0, then exit.
-            {
-                out = allocator(bom_size);
-                if (bom_chars)
-                {
-                    // std::copy(bom_chars, bom_chars + bom_size, out);
-                    // out += bom_size;
-                    for (auto i = 0; i != bom_size; ++i)
-                    {
-                        *out++ = *(bom_chars + i);
-                    }
-                }
-                return ;
-            }
-            else if (out_size != 0)
-            {
-                out = allocator(out_size);
-                if (bom_chars)
-                {
-                    // std::copy(bom_chars, bom_chars + bom_size, out);
-                    // out += bom_size;
-                    for (auto i = 0; i != bom_size; ++i)
-                    {
-                        *out++ = *(bom_chars + i);
-                    }
-                }
-            }
-            out_size = detail::WideCharToMultiByte(this->cp_
-                                                   , wstr, in_size
-                                                   , out, out_size);
-            if (out_size == 0)
-            {
-                throw std::system_error(std::error_code(::GetLastError()
-                                                        , std::system_category())
-                                        , "Failed encode");
-            }
+            progress_step((position - done_) * unit_size_, count_);
+            done_ = position;
+            mark_ = position + g_chunk_size;
         }
     }
 
-    virtual void decode_impl(char const* bytes, int in_size, int& out_size
-                             , codec_impl::alloc4de_t const& allocator) const
+    void finish(std::size_t position)
     {
-        auto const bom_size = this->get_bom().first;
-        auto const bom_chars = this->get_bom().second;
-        if (bom_chars && in_size >= bom_size)
-            // skip bom chars
+        if (position > done_)
         {
-            auto p_bytes = bytes;
-            for (auto p_bom = bom_chars
-                 ; p_bom < bom_chars + bom_size
-                 ; ++p_bom, ++p_bytes)
-            {
-                if (*p_bom != static_cast<decltype(*p_bom)>(*p_bytes))
-                {
-                    break;
-                }
-            }
-            if (p_bytes - bytes == bom_size)
-            {
-                bytes   += bom_size;
-                in_size -= bom_size;
-            }
+            progress_step((position - done_) * unit_size_, count_);
+            done_ = position;
         }
+    }
 
-        wchar_t* out = nullptr;
-        for (out_size = 0; !out && in_size; )
-            // exit if in_size == 0
+private:
+    std::size_t unit_size_;
+    std::size_t done_;
+    std::size_t mark_;
+    bool count_;
+};
+
+// a call running several loops, e.g. read then decode, reports the bytes
+// of its input once: only its first loop counts.
+class progress_call
+{
+public:
+    progress_call()
+        : state_(current_progress())
+    {
+        if (state_ && !state_->calls++)
         {
-            if (out_size != 0)
-            {
-                out = allocator(out_size);
-            }
-            out_size = detail::MultiByteToWideChar(this->cp_
-                                                   , bytes, in_size
-                                                   , out, out_size);
-            if (out_size == 0)
-            {
-                throw std::system_error(
-                    std::error_code(::GetLastError()
-                                    , std::system_category())
-                    , "Failed decode");
-            }
+            state_->counted = false;
         }
     }
-};
 
-} // namespace detail
+    progress_call(progress_call const&) = delete;
+    progress_call& operator=(progress_call const&) = delete;
 
-#endif // _WIN32 || _MSC_VER
+    ~progress_call()
+    {
+        if (state_)
+        {
+            --state_->calls;
+        }
+    }
 
-/*****************************************************************************/
-/* IConv Implement. */
+private:
+    progress_state* state_;
+};
 
-#if defined(YMH_UNA_WITH_ICONV)
+// no scope in it, for conversions that aren't of input.
+class progress_pause
+{
+public:
+    progress_pause()
+        : state_(current_progress())
+    {
+        current_progress() = nullptr;
+    }
 
-namespace detail
+    progress_pause(progress_pause const&) = delete;
+    progress_pause& operator=(progress_pause const&) = delete;
+
+    ~progress_pause()
+    {
+        current_progress() = state_;
+    }
+
+private:
+    progress_state* state_;
+};
+
+}  // namespace detail
+
+namespace progress
 {
 
-inline std::string default_wide_charset()
+// report every `every` bytes to notify, and stop by cancel. Scopes nest,
+// the inner one replaces the outer one until it ends.
+class scope
 {
-    union {
-        std::uint16_t n;
-        unsigned char c[sizeof(std::uint16_t)];
-    };
-    n = 0x0102;
+public:
+    explicit scope(callback const& notify
+                   , std::uint64_t every = 64 * 1024 * 1024
+                   , token const& cancel = token())
+        : previous_(detail::current_progress())
+    {
+        state_.notify = notify;
+        state_.cancel = cancel;
+        state_.every = every ? every : 1;
+        state_.bytes = 0;
+        state_.next = state_.every;
+        state_.start = std::chrono::steady_clock::now();
+        state_.calls = 0;
+        state_.counted = false;
+        detail::current_progress() = &state_;
+    }
 
-    auto const big_endian = (c[0] == 0x01 && c[1] == 0x02);
-    auto const byte_size = sizeof(wchar_t);
+    explicit scope(token const& cancel)
+        : scope(callback(), 64 * 1024 * 1024, cancel)
+    {}
 
-    if (byte_size == 4)
+    scope(scope const&) = delete;
+    scope& operator=(scope const&) = delete;
+
+    ~scope()
     {
-        return big_endian ? "UCS-4BE" : "UCS-4LE";
+        detail::current_progress() = previous_;
     }
-    return big_endian ? "UCS-2BE" : "UCS-2LE";
-}
 
-inline std::string to_iconv_codepage(codepage::type cp)
-{
-    using namespace codepage;
-    switch(cp)
+    std::uint64_t bytes() const
     {
-    case cp_default:
+        return state_.bytes;
+    }
+
+private:
+    detail::progress_state state_;
+    detail::progress_state* previous_;
+};
+
+}  // namespace progress
+
+/*****************************************************************************/
+/* Abstract Platform Implement. */
+
+namespace detail
+{
+
+class codec_impl
+{
+public:
+    typedef std::function<char* (std::size_t)> alloc4en_t;
+    typedef std::function<wchar_t* (std::size_t)> alloc4de_t;
+
+public:
+    codec_impl(codepage::type cp, bom::type bo
+               , policy::type po = policy::strict
+               , std::string const& replacement = std::string()
+               , normalize::type nl = normalize::none)
+        : cp_(cp), bom_(bo), po_(po), replacement_(replacement), nl_(nl)
+    {}
+
+    virtual ~codec_impl()
+    {}
+
+    static std::shared_ptr<codec_impl>
+    create_instance(codepage::type cp, bom::type bo
+                    , policy::type po = policy::strict
+                    , std::string const& replacement = std::string()
+                    , normalize::type nl = normalize::none);
+
+    // return the number of invalid sequences handled by policy.
+    virtual std::size_t encode_impl(wchar_t const* wstr, std::size_t in_size
+                                    , std::size_t& out_size
+                                    , alloc4en_t const& allocator) const = 0;
+
+    virtual std::size_t decode_impl(char const* bytes, std::size_t in_size
+                                    , std::size_t& out_size
+                                    , alloc4de_t const& allocator) const = 0;
+
+protected:
+    // bytes of one code unit, resume at next unit if invalid.
+    std::size_t unit_size() const
     {
-        std::locale loc("");
-        auto name = loc.name();
-        auto bp = name.find('.');
-        auto ep = name.find('@', bp);
-        return name.substr(bp == std::string::npos ? bp : bp + 1, ep);
+        using namespace codepage;
+        return (cp_ == cp_ucs2_le || cp_ == cp_ucs2_be) ? 2 : 1;
     }
-    case cp_utf8:    return "UTF-8";
-    case cp_gb2312:  return "CP936";
-    case cp_gb18030: return "GB18030";
-    case cp_ucs2_le: return "UCS-2LE";
-    case cp_ucs2_be: return "UCS-2BE";
+
+protected:
+    std::pair<std::size_t, unsigned char const*> get_bom() const
+    {
+        if (bom_ == bom::nobomb)
+        {
+            std::size_t size = 0;
+            unsigned char const* chars = nullptr;
+            return std::make_pair(size, chars);
+        }
+        return detail::get_bom(this->cp_);
     }
-    return "";
-}
 
-class iconv_impl : public codec_impl
+protected:
+    codepage::type cp_;
+    bom::type bom_;
+    policy::type po_;
+    std::string replacement_;  // encode only, empty for default
+    normalize::type nl_;       // decode only
+};
+
+}  // namespace detail
+
+/*****************************************************************************/
+/* Codec Bridge Interface. */
+
+class codec
 {
 public:
-    iconv_impl(codepage::type cp, bom::type bo)
-        : codec_impl(cp, bo)
+    typedef detail::char_ptr char_ptr;
+    typedef detail::wchar_ptr wchar_ptr;
+
+    // Deprecated: Use ymh::bom::xx instead of ymh::codec::xx
+    static CONSTEXPR auto bomb   = bom::bomb;
+    static CONSTEXPR auto nobomb = bom::nobomb;
+
+    // Deprecated: Use ymh::codepage:xx instead of ymh::codec::xx
+    static CONSTEXPR auto cp_default = codepage::cp_default;
+    static CONSTEXPR auto cp_utf8    = codepage::cp_utf8;
+    static CONSTEXPR auto cp_gb2312  = codepage::cp_gb2312;
+    static CONSTEXPR auto cp_gb18030 = codepage::cp_gb18030;
+    static CONSTEXPR auto cp_ucs2_le = codepage::cp_ucs2_le;
+    static CONSTEXPR auto cp_ucs2_be = codepage::cp_ucs2_be;
+
+public:
+    explicit codec(codepage::type cp = codepage::cp_default
+                   , bom::type bo = bom::nobomb
+                   , policy::type po = policy::strict
+                   , std::string const& replacement = std::string()
+                   , normalize::type nl = normalize::none)
+        : cp_(cp), bom_(bo), po_(po), replacement_(replacement), nl_(nl)
     {}
 
-    virtual void encode_impl(wchar_t const* wstr, int in_size, int& out_size
-                             , codec_impl::alloc4en_t const& allocator) const
+    virtual ~codec()
+    {}
+
+    char_ptr encode(wchar_t const* wstr
+                    , std::size_t in_size, std::size_t& out_size) const
     {
-        auto const bom_size = this->get_bom().first;
-        auto const bom_chars = this->get_bom().second;
+        std::size_t invalid = 0;
+        return encode(wstr, in_size, out_size, invalid);
+    }
 
-        char* out = nullptr;
-        for (out_size = 0; !out; out_size += bom_size)
+    // invalid: the number of unencodable characters handled by policy.
+    char_ptr encode(wchar_t const* wstr
+                    , std::size_t in_size, std::size_t& out_size
+                    , std::size_t& invalid) const
+    {
+        char_ptr out_ptr;
+        std::size_t out_num = 0;
+
+        auto alloc = [&out_ptr, &out_num](std::size_t n) -> char*
         {
-            if (!in_size)
-                // fill BOM if in_size == 0, then exit.
+            out_num = n;
+            char* cp = nullptr;
+
+            if (out_ptr)
             {
-                out = allocator(bom_size);
-                if (bom_chars)
-                {
-                    // std::copy(bom_chars, bom_chars + bom_size, out);
-                    // out += bom_size;
-                    for (auto i = 0; i != bom_size; ++i)
-                    {
-                        *out++ = *(bom_chars + i);
-                    }
-                }
-                return ;
+                cp = (char*)::realloc(out_ptr.release()
+                                      , out_num * sizeof(char));
             }
-            else if (out_size != 0)
+            else
             {
-                out = allocator(out_size);
-                if (bom_chars)
-                {
-                    // std::copy(bom_chars, bom_chars + bom_size, out);
-                    // out += bom_size;
-                    for (auto i = 0; i != bom_size; ++i)
-                    {
-                        *out++ = *(bom_chars + i);
-                    }
-                }
+                cp = (char*)::calloc(out_num, sizeof(char));
             }
 
-            if (out_size == 0)
-                // calculate out buffer size.
+            if (!cp)
             {
-                // perhaps too large, but that's OK
-                // encodings like shift-JIS need some prefix space
-                CONSTEXPR auto ratio = 4;
-                out_size = in_size * ratio + 4;
-                continue ;
+                throw std::system_error(
+                    std::make_error_code(
+                        std::errc::not_enough_memory)
+                    , "Allocate memory for encode");
             }
 
-            if (this->cp_ == codepage::cp_default)
-                // Unicode to ANSI
-            {
-                typedef wchar_t from_type;
-                typedef char to_type;
-                typedef std::codecvt<from_type
-                                     , to_type, std::mbstate_t> cvt_facet;
+            char_ptr p(cp);
+            out_ptr.swap(p);
 
-                std::locale loc("");
-                auto& cvt = std::use_facet<cvt_facet>(loc);
-                for ( ; ; )
-                {
-                    from_type const* fb = wstr;
-                    from_type const* fe = wstr + in_size;
-                    from_type const* fn = nullptr;
+            return out_ptr.get();
+        };
+        
+        invalid = encode_impl(wstr, in_size, out_size, alloc);
+        if (out_size < out_num)
+        {
+            out_ptr[out_size] = '\0';
+        }
+        return std::move(out_ptr);
+    }
 
-                    to_type* tb = const_cast<to_type*>(out);
-                    to_type* te = const_cast<to_type*>(
-                        out + out_size - bom_size);
-                    to_type* tn = nullptr;
+    std::string encode(std::wstring const& wstr) const
+    {
+        std::size_t invalid = 0;
+        return encode(wstr, invalid);
+    }
 
-                    std::mbstate_t state = std::mbstate_t();
-                    auto result = cvt.out(state, fb, fe, fn, tb, te, tn);
-                    if (result == cvt_facet::ok || result == cvt_facet::noconv)
-                    {
-                        out_size = (tn - tb) + bom_size;
-                        return ;
-                    }
-                    else if (result == cvt_facet::partial)
-                    {
-                        out_size += BUFSIZ;
-                        out = allocator(out_size) + bom_size;
-                        continue;
-                    }
+    std::string encode(std::wstring const& wstr, std::size_t& invalid) const
+    {
+        std::size_t out_size = 0;
+        std::string out;
+        invalid = encode_impl(wstr.data(), wstr.size(), out_size
+                              , [&out](std::size_t n) -> char*
+                              {
+                                  out.resize(n);
+                                  return const_cast<char*>(out.data());
+                              });
+        out.resize(out_size);
+        return out;
+    }
 
-                    // failed
-                    throw std::system_error(
-                        std::make_error_code(std::errc::illegal_byte_sequence)
-                        , "std::codecvt for encode");
-                }
-                return ;
-            }
+    wchar_ptr decode(char const* bytes
+                     , std::size_t in_size, std::size_t& out_size) const
+    {
+        std::size_t invalid = 0;
+        return decode(bytes, in_size, out_size, invalid);
+    }
 
-            // open
-            auto cd = ::iconv_open(to_iconv_codepage(this->cp_).c_str()
-                                   , default_wide_charset().c_str());
-            if (cd == (iconv_t)(-1))
-            {
-                throw std::system_error(
-                    std::error_code(errno, std::system_category())
-                    , "iconv_open for encode");
-            }
+    // invalid: the number of invalid sequences handled by policy.
+    wchar_ptr decode(char const* bytes
+                     , std::size_t in_size, std::size_t& out_size
+                     , std::size_t& invalid) const
+    {
+        wchar_ptr out_ptr;
+        std::size_t out_num = 0;
 
-            // iconv
-            char* inbuf = (char*)wstr;
-            size_t inbytesleft = sizeof(wchar_t) * in_size;
-            char* outbuf = out;
-            size_t outbytesleft = out_size - bom_size;
+        auto alloc = [&out_ptr, &out_num](std::size_t n) -> wchar_t*
+        {
+            out_num = n;
+            wchar_t* cp = nullptr;
 
-            ::iconv(cd, nullptr, nullptr, nullptr, nullptr);
-            for ( ; ; )
+            if (out_ptr)
             {
-                auto rv = ::iconv(cd
-                                  , &inbuf, &inbytesleft
-                                  , &outbuf, &outbytesleft);
-                if (rv == static_cast<size_t>(-1))
-                {
-                    if (errno == E2BIG)
-                        // outbuf is too small, increment its size.
-                    {
-                        outbuf = allocator(out_size + BUFSIZ);
-                        outbuf += (out_size - outbytesleft);
-                        outbytesleft += BUFSIZ;
-                        out_size += BUFSIZ;
-                        continue;
-                    }
-
-                    ::iconv_close(cd);
-                    throw std::system_error(
-                        std::error_code(errno, std::system_category())
-                        , "iconv for encode");
-                }
-
-                out_size -= outbytesleft;
-                break;
+                cp = (wchar_t*)::realloc(
+                    out_ptr.release()
+                    , out_num * sizeof(wchar_t));
+            }
+            else
+            {
+                cp = (wchar_t*)::calloc(out_num, sizeof(wchar_t));
             }
 
-            // close
-            if (::iconv_close(cd) == -1)
+            if (!cp)
             {
                 throw std::system_error(
-                    std::error_code(errno, std::system_category())
-                    , "iconv_close for encode");
+                    std::make_error_code(
+                        std::errc::not_enough_memory)
+                    , "Allocate memory for decode");
+            }
+
+            wchar_ptr p(cp);
+            out_ptr.swap(p);
+
+            return out_ptr.get();
+        };
+
+        invalid = decode_impl(bytes, in_size, out_size, alloc);
+        if (out_size < out_num)
+        {
+            out_ptr.get()[out_size] = L'\0';
+        }
+        return std::move(out_ptr);
+    }
+
+    std::wstring decode(std::string const& bytes) const
+    {
+        std::size_t invalid = 0;
+        return decode(bytes, invalid);
+    }
+
+    std::wstring decode(std::string const& bytes, std::size_t& invalid) const
+    {
+        std::wstring out;
+        std::size_t out_size = 0;
+        invalid = decode_impl(bytes.data(), bytes.size(), out_size
+                              , [&out](std::size_t n) -> wchar_t*
+                              {
+                                  out.resize(n);
+                                  return const_cast<wchar_t*>(out.data());
+                              });
+        out.resize(out_size);
+        return out;
+    }
+
+public:
+    char_ptr operator()(wchar_t const* wstr
+                        , std::size_t in_size, std::size_t& out_size) const
+    {
+        return encode(wstr, in_size, out_size);
+    }
+
+    std::string operator()(std::wstring const& wstr) const
+    {
+        return encode(wstr);
+    }
+
+    wchar_ptr operator()(char const* bytes
+                         , std::size_t in_size, std::size_t& out_size) const
+    {
+        return decode(bytes, in_size, out_size);
+    }
+
+    std::wstring operator()(std::string const& bytes) const
+    {
+        return decode(bytes);
+    }
+
+private:
+    // allocator: char* allocator(std::size_t size);
+    template <class AllocatorT>
+    std::size_t encode_impl(wchar_t const* wstr, std::size_t in_size
+                            , std::size_t& out_size
+                            , AllocatorT const& allocator) const
+    {
+        detail::stats_scope scope(stats::wide, cp_
+                                  , sizeof(wchar_t) * in_size);
+        auto ci = detail::codec_impl::create_instance(cp_, bom_, po_
+                                                      , replacement_, nl_);
+        auto const invalid = ci->encode_impl(wstr, in_size, out_size
+                                             , allocator);
+        scope.done(out_size);
+        return invalid;
+    }
+
+    // allocator: wchar_t* allocator(std::size_t size);
+    template <class AllocatorT>
+    std::size_t decode_impl(char const* bytes, std::size_t in_size
+                            , std::size_t& out_size
+                            , AllocatorT const& allocator) const
+    {
+        detail::stats_scope scope(cp_, stats::wide, in_size);
+        auto ci = detail::codec_impl::create_instance(cp_, bom_, po_
+                                                      , replacement_, nl_);
+        auto const invalid = ci->decode_impl(bytes, in_size, out_size
+                                             , allocator);
+        scope.done(sizeof(wchar_t) * out_size);
+        return invalid;
+    }
+
+private:
+    codepage::type cp_;
+    bom::type bom_;
+    policy::type po_;
+    std::string replacement_;
+    normalize::type nl_;
+};
+
+/*****************************************************************************/
+/* Windows Implement. */
+
+#if defined(_WIN32) || defined(_MSC_VER)
+
+//
+// WideCharToMultiByte、MultiByteToWideChar Implement.
+//
+namespace detail
+{
+namespace ucs2_le
+{
+
+inline int WideCharToMultiByte(wchar_t const* wstr, int in_size
+                               , char* out, int out_size)
+{
+    auto const in_byte_size = in_size * static_cast<int>
+    (sizeof(wchar_t) / sizeof(char));
+    if (out_size == 0)
+    {
+        return in_byte_size;
+    }
+
+    auto in = (unsigned char const*)wstr;
+    for (int i = 0
+         ; i != (in_byte_size < out_size ? in_byte_size : out_size)
+         ; ++i)
+    {
+        *(out + i) = *(in + i);
+    }
+    return out_size;
+}
+
+inline int MultiByteToWideChar(char const* bytes, int in_size
+                               , wchar_t* out, int out_size)
+{
+    auto const out_wchar_size = in_size / static_cast<int>
+    (sizeof(wchar_t) / sizeof(char));
+    if (out_size == 0)
+    {
+        return out_wchar_size;
+    }
+
+    auto p_out = (unsigned char*)out;
+    auto const out_byte_size = out_size * static_cast<int>
+    (sizeof(wchar_t) / sizeof(char));
+    for (int i = 0
+         ; i != (in_size < out_byte_size ? in_size : out_byte_size)
+         ; ++i)
+    {
+        *(p_out + i) = *(bytes + i);
+    }
+    return out_size;
+}
+
+inline bool is_ucs2_le(char const* bytes, std::size_t in_size)
+{
+    // IsTextUnicode is a heuristic, the head of large text is enough.
+    CONSTEXPR std::size_t limit = (std::numeric_limits<int>::max)();
+    auto n = static_cast<int>((std::min)(in_size, limit));
+    if (n % 2)
+        // ucs2 byte size is even
+    {
+        --n;
+    }
+
+    return ::IsTextUnicode(reinterpret_cast<void const*>(bytes)
+                           , n, nullptr) ? true : false;
+}
+
+inline bool is_ucs2_le(std::string const& bytes)
+{
+    return is_ucs2_le(bytes.data(), bytes.size());
+}
+
+} // namespace ucs2_le
+
+namespace ucs2_be
+{
+
+inline int WideCharToMultiByte(wchar_t const* wstr, int in_size
+                               , char* out, int out_size)
+{
+    auto const in_byte_size = in_size * static_cast<int>
+    (sizeof(wchar_t) / sizeof(char));
+    if (out_size == 0)
+    {
+        return in_byte_size;
+    }
+
+    auto in = (unsigned char const*)wstr;
+    for (int i = 0
+         ; i != (in_byte_size < out_size ? in_byte_size : out_size)
+         ; ++i)
+    {
+        *(out + i) = *(in + ((i % 2 == 0) ? (i + 1) : (i - 1)));
+    }
+    return out_size;
+}
+
+inline int MultiByteToWideChar(char const* bytes, int in_size
+                               , wchar_t* out, int out_size)
+{
+    auto const out_wchar_size = in_size / static_cast<int>
+    (sizeof(wchar_t) / sizeof(char));
+    if (out_size == 0)
+    {
+        return out_wchar_size;
+    }
+
+    auto p_out = (unsigned char*)out;
+    auto const out_byte_size = out_size * static_cast<int>
+    (sizeof(wchar_t) / sizeof(char));
+    for (int i = 0
+         ; i != (in_size < out_byte_size ? in_size : out_byte_size)
+         ; ++i)
+    {
+        *(p_out + i) = *(bytes + ((i % 2 == 0) ? (i + 1) : (i - 1)));
+    }
+    return out_size;
+}
+
+} // namespace ucs2_be
+
+inline int to_win_codepage(codepage::type cp)
+{
+    using namespace codepage;
+    switch(cp)
+    {
+    case cp_default: return CP_ACP;
+    case cp_utf8:    return CP_UTF8;
+    case cp_gb2312:  return 936;
+    case cp_gb18030: return 54936;
+    case cp_ucs2_le: return 1200;
+    case cp_ucs2_be: return 1201;
+    case cp_latin1:  return 28591;
+    }
+    return cp;
+}
+
+inline int WideCharToMultiByte(codepage::type cp
+                               , wchar_t const* wstr, int in_size
+                               , char* out, int out_size)
+{
+    using namespace codepage;
+    switch (cp)
+    {
+    case cp_ucs2_le:
+        return ucs2_le::WideCharToMultiByte(wstr, in_size, out, out_size);
+    case cp_ucs2_be:
+        return ucs2_be::WideCharToMultiByte(wstr, in_size, out, out_size);
+    default:
+        break;
+    }
+    return ::WideCharToMultiByte(to_win_codepage(cp), 0
+                                 , wstr, in_size
+                                 , out, out_size
+                                 , nullptr, nullptr);
+}
+
+inline int MultiByteToWideChar(codepage::type cp
+                               , char const* bytes, int in_size
+                               , wchar_t* out, int out_size)
+{
+    using namespace codepage;
+    switch (cp)
+    {
+    case cp_ucs2_le:
+        return ucs2_le::MultiByteToWideChar(bytes, in_size, out, out_size);
+    case cp_ucs2_be:
+        return ucs2_be::MultiByteToWideChar(bytes, in_size, out, out_size);
+    default:
+        break;
+    }
+    return ::MultiByteToWideChar(to_win_codepage(cp), 0
+                                 , bytes, in_size
+                                 , out, out_size);
+}
+
+//
+// Windows API takes int sizes, so convert chunk by chunk.
+//
+// cut wide string before a high surrogate.
+inline int win_wide_chunk(wchar_t const* wstr, std::size_t in_size)
+{
+    // UTF-8 needs 3 bytes for one UTF-16 unit at most.
+    CONSTEXPR std::size_t limit = (std::numeric_limits<int>::max)() / 4;
+    if (in_size <= limit)
+    {
+        return static_cast<int>(in_size);
+    }
+
+    auto n = limit;
+    auto const c = static_cast<std::uint32_t>(wstr[n - 1]);
+    if (0xD800 <= c && c <= 0xDBFF)
+    {
+        --n;
+    }
+    return static_cast<int>(n);
+}
+
+// cut bytes in a character boundary.
+inline int win_byte_chunk(codepage::type cp
+                          , char const* bytes, std::size_t in_size)
+{
+    CONSTEXPR std::size_t limit = (std::numeric_limits<int>::max)();
+    if (in_size <= limit)
+    {
+        return static_cast<int>(in_size);
+    }
+
+    using namespace codepage;
+    if (cp == cp_ucs2_le || cp == cp_ucs2_be)
+    {
+        return static_cast<int>(limit & ~static_cast<std::size_t>(1));
+    }
+
+    for (auto n = limit; n != 0; --n)
+    {
+        auto const c = static_cast<unsigned char>(bytes[n - 1]);
+        auto const next = static_cast<unsigned char>(bytes[n]);
+        if (cp == cp_utf8 ? (next & 0xC0) != 0x80
+                          : c < 0x30)  // never be a part of multi bytes.
+        {
+            return static_cast<int>(n);
+        }
+    }
+    return static_cast<int>(limit);
+}
+
+//
+// Windows Codec Implement.
+//
+// @note invalid sequences are substituted by the system default
+//       replacement character whatever the policy is, and are not counted.
+class win_impl : public codec_impl
+{
+public:
+    win_impl(codepage::type cp, bom::type bo
+             , policy::type po = policy::strict
+             , std::string const& replacement = std::string()
+             , normalize::type nl = normalize::none)
+        : codec_impl(cp, bo, po, replacement, nl)
+    {}
+
+    virtual std::size_t encode_impl(wchar_t const* wstr, std::size_t in_size
+                                    , std::size_t& out_size
+                                    , codec_impl::alloc4en_t const& allocator
+                                    ) const
+    {
+        auto const bom_size = this->get_bom().first;
+        auto const bom_chars = this->get_bom().second;
+
+        char* out = allocator(bom_size);
+        if (bom_chars)
+        {
+            std::copy(bom_chars, bom_chars + bom_size, out);
+        }
+        if (!in_size)
+            // fill BOM if in_size == 0, then exit.
+        {
+            out_size = 0;
+            return 0;
+        }
+
+        out_size = bom_size;
+        for (std::size_t i = 0; i != in_size; )
+        {
+            auto const n = win_wide_chunk(wstr + i, in_size - i);
+            auto const m = detail::WideCharToMultiByte(this->cp_
+                                                       , wstr + i, n
+                                                       , nullptr, 0);
+            if (m == 0 || (out = allocator(out_size + m)
+                           , detail::WideCharToMultiByte(this->cp_
+                                                         , wstr + i, n
+                                                         , out + out_size
+                                                         , m) == 0))
+            {
+                throw std::system_error(std::error_code(::GetLastError()
+                                                        , std::system_category())
+                                        , "Failed encode");
+            }
+            out_size += m;
+            i += n;
+        }
+        return 0;
+    }
+
+    virtual std::size_t decode_impl(char const* bytes, std::size_t in_size
+                                    , std::size_t& out_size
+                                    , codec_impl::alloc4de_t const& allocator
+                                    ) const
+    {
+        auto const bom_size = this->get_bom().first;
+        auto const bom_chars = this->get_bom().second;
+        if (bom_chars && in_size >= bom_size)
+            // skip bom chars
+        {
+            auto p_bytes = bytes;
+            for (auto p_bom = bom_chars
+                 ; p_bom < bom_chars + bom_size
+                 ; ++p_bom, ++p_bytes)
+            {
+                if (*p_bom != static_cast<decltype(*p_bom)>(*p_bytes))
+                {
+                    break;
+                }
+            }
+            if (static_cast<std::size_t>(p_bytes - bytes) == bom_size)
+            {
+                bytes   += bom_size;
+                in_size -= bom_size;
+            }
+        }
+
+        wchar_t* out = nullptr;
+        out_size = 0;
+        for (std::size_t i = 0; i != in_size; )
+            // exit if in_size == 0
+        {
+            auto const n = win_byte_chunk(this->cp_, bytes + i, in_size - i);
+            auto const m = detail::MultiByteToWideChar(this->cp_
+                                                       , bytes + i, n
+                                                       , nullptr, 0);
+            if (m == 0 || (out = allocator(out_size + m)
+                           , detail::MultiByteToWideChar(this->cp_
+                                                         , bytes + i, n
+                                                         , out + out_size
+                                                         , m) == 0))
+            {
+                throw std::system_error(
+                    std::error_code(::GetLastError()
+                                    , std::system_category())
+                    , "Failed decode");
+            }
+            out_size += m;
+            i += n;
+        }
+
+        basic_newline_filter<wchar_t> filter(this->nl_);
+        if (out && filter)
+        {
+            out_size = filter(out, out + out_size) - out;
+        }
+        return 0;
+    }
+};
+
+} // namespace detail
+
+#endif // _WIN32 || _MSC_VER
+
+/*****************************************************************************/
+/* IConv Implement. */
+
+#if defined(YMH_UNA_WITH_ICONV)
+
+namespace detail
+{
+
+inline std::string default_wide_charset()
+{
+    union {
+        std::uint16_t n;
+        unsigned char c[sizeof(std::uint16_t)];
+    };
+    n = 0x0102;
+
+    auto const big_endian = (c[0] == 0x01 && c[1] == 0x02);
+    auto const byte_size = sizeof(wchar_t);
+
+    if (byte_size == 4)
+    {
+        return big_endian ? "UCS-4BE" : "UCS-4LE";
+    }
+    return big_endian ? "UCS-2BE" : "UCS-2LE";
+}
+
+inline std::string to_iconv_codepage(codepage::type cp)
+{
+    using namespace codepage;
+    switch(cp)
+    {
+    case cp_default:
+    {
+        std::locale loc("");
+        auto name = loc.name();
+        auto bp = name.find('.');
+        auto ep = name.find('@', bp);
+        return name.substr(bp == std::string::npos ? bp : bp + 1, ep);
+    }
+    case cp_utf8:    return "UTF-8";
+    case cp_gb2312:  return "CP936";
+    case cp_gb18030: return "GB18030";
+    case cp_ucs2_le: return "UCS-2LE";
+    case cp_ucs2_be: return "UCS-2BE";
+    case cp_latin1:  return "ISO-8859-1";
+    }
+    return "";
+}
+
+class iconv_impl : public codec_impl
+{
+public:
+    iconv_impl(codepage::type cp, bom::type bo
+               , policy::type po = policy::strict
+               , std::string const& replacement = std::string()
+               , normalize::type nl = normalize::none)
+        : codec_impl(cp, bo, po, replacement, nl)
+    {}
+
+    virtual std::size_t encode_impl(wchar_t const* wstr
+                                    , std::size_t in_size, std::size_t& out_size
+                                    , codec_impl::alloc4en_t const& allocator
+                                    ) const
+    {
+        auto const bom_size = this->get_bom().first;
+        auto const bom_chars = this->get_bom().second;
+
+        std::size_t invalid = 0;
+        char* out = nullptr;
+        for (out_size = 0; !out; out_size += bom_size)
+        {
+            if (!in_size)
+                // fill BOM if in_size == 0, then exit.
+            {
+                out = allocator(bom_size);
+                if (bom_chars)
+                {
+                    // std::copy(bom_chars, bom_chars + bom_size, out);
+                    // out += bom_size;
+                    for (std::size_t i = 0; i != bom_size; ++i)
+                    {
+                        *out++ = *(bom_chars + i);
+                    }
+                }
+                return invalid;
+            }
+            else if (out_size != 0)
+            {
+                out = allocator(out_size);
+                if (bom_chars)
+                {
+                    // std::copy(bom_chars, bom_chars + bom_size, out);
+                    // out += bom_size;
+                    for (std::size_t i = 0; i != bom_size; ++i)
+                    {
+                        *out++ = *(bom_chars + i);
+                    }
+                }
+            }
+
+            if (out_size == 0)
+                // calculate out buffer size.
+            {
+                // perhaps too large, but that's OK
+                // encodings like shift-JIS need some prefix space
+                CONSTEXPR auto ratio = 4;
+                out_size = in_size * ratio + 4;
+                continue ;
+            }
+
+            if (this->cp_ == codepage::cp_default)
+                // Unicode to ANSI
+            {
+                typedef wchar_t from_type;
+                typedef char to_type;
+                typedef std::codecvt<from_type
+                                     , to_type, std::mbstate_t> cvt_facet;
+
+                std::string const repl = this->replacement_.empty()
+                    ? std::string(1, '?') : this->replacement_;
+
+                std::locale loc("");
+                auto& cvt = std::use_facet<cvt_facet>(loc);
+
+                from_type const* fn = wstr;
+                from_type const* fe = wstr + in_size;
+                std::size_t done = 0;  // except bom
+                std::mbstate_t state = std::mbstate_t();
+                progress_meter meter(sizeof(from_type));
+                while (fn != fe)
+                {
+                    meter(static_cast<std::size_t>(fn - wstr));
+                    from_type const* fb = fn;
+                    from_type const* ce = (fe - fn > g_chunk_size)
+                        ? fn + g_chunk_size : fe;
+
+                    to_type* tb = const_cast<to_type*>(out + done);
+                    to_type* te = const_cast<to_type*>(
+                        out + out_size - bom_size);
+                    to_type* tn = nullptr;
+
+                    auto result = cvt.out(state, fb, ce, fn, tb, te, tn);
+                    done = static_cast<std::size_t>(tn - out);
+                    if (result == cvt_facet::ok && fn != fe)
+                        // next chunk
+                    {
+                        continue;
+                    }
+                    if (result == cvt_facet::ok || result == cvt_facet::noconv)
+                    {
+                        break;
+                    }
+                    else if (result == cvt_facet::partial)
+                    {
+                        stats_add(stats::wide, this->cp_, stats::regrowths);
+                        out_size += BUFSIZ;
+                        out = allocator(out_size) + bom_size;
+                        continue;
+                    }
+
+                    // failed
+                    if (this->po_ == policy::strict)
+                    {
+                        throw std::system_error(
+                            std::make_error_code(
+                                std::errc::illegal_byte_sequence)
+                            , "std::codecvt for encode");
+                    }
+
+                    ++invalid;
+                    if (this->po_ == policy::stop)
+                    {
+                        break;
+                    }
+                    if (this->po_ == policy::replace)
+                    {
+                        auto const repl_size = repl.size();
+                        if (out_size - bom_size - done < repl_size)
+                        {
+                            out_size += BUFSIZ + repl_size;
+                            out = allocator(out_size) + bom_size;
+                        }
+                        std::copy(repl.begin(), repl.end(), out + done);
+                        done += repl_size;
+                    }
+                    ++fn;  // resume at next character
+                    state = std::mbstate_t();
+                }
+                meter.finish(static_cast<std::size_t>(fn - wstr));
+                out_size = done + bom_size;
+                return invalid;
+            }
+
+            auto const cd = descriptor(true);
+
+            // iconv
+            char* inbuf = (char*)wstr;
+            size_t inbytesleft = sizeof(wchar_t) * in_size;
+            char* outbuf = out;
+            size_t outbytesleft = out_size - bom_size;
+
+            // outbuf is too small, increment its size.
+            auto grow = [&](std::size_t n)
+            {
+                stats_add(stats::wide, this->cp_, stats::regrowths);
+                outbuf = allocator(out_size + n);
+                outbuf += (out_size - outbytesleft);
+                outbytesleft += n;
+                out_size += n;
+            };
+
+            std::string repl = this->replacement_;
+            progress_meter meter;
+            for ( ; ; )
+            {
+                // chunk by chunk.
+                meter(static_cast<std::size_t>(inbuf - (char*)wstr));
+                size_t chunkleft = (std::min)(
+                    inbytesleft, sizeof(wchar_t) * g_chunk_size);
+                auto const chunk = chunkleft;
+                auto rv = ::iconv(cd
+                                  , &inbuf, &chunkleft
+                                  , &outbuf, &outbytesleft);
+                inbytesleft -= chunk - chunkleft;
+                if (rv != static_cast<size_t>(-1))
+                {
+                    if (!inbytesleft)
+                    {
+                        break;
+                    }
+                    continue;
+                }
+
+                auto const err = errno;
+                if (err == E2BIG)
+                {
+                    grow(BUFSIZ);
+                    continue;
+                }
+
+                if ((err == EILSEQ || err == EINVAL)
+                    && this->po_ != policy::strict)
+                    // unencodable character, resume at the next one.
+                {
+                    ++invalid;
+                    if (this->po_ == policy::stop)
+                    {
+                        break;
+                    }
+                    if (this->po_ == policy::replace)
+                    {
+                        if (repl.empty())
+                        {
+                            repl = default_replacement(cd);
+                        }
+                        if (outbytesleft < repl.size())
+                        {
+                            grow(BUFSIZ + repl.size());
+                        }
+                        outbuf = std::copy(repl.begin(), repl.end(), outbuf);
+                        outbytesleft -= repl.size();
+                    }
+                    auto const n = (err == EINVAL) ? inbytesleft
+                        : (std::min)(inbytesleft, sizeof(wchar_t));
+                    inbuf += n;
+                    inbytesleft -= n;
+                    continue;
+                }
+
+                throw std::system_error(
+                    std::error_code(err, std::system_category())
+                    , "iconv for encode");
+            }
+            meter.finish(static_cast<std::size_t>(inbuf - (char*)wstr));
+            out_size -= outbytesleft;
+            return invalid;  // out_size includes bom already
+        }
+        return invalid;
+    }
+
+    virtual std::size_t decode_impl(char const* bytes
+                                    , std::size_t in_size, std::size_t& out_size
+                                    , codec_impl::alloc4de_t const& allocator
+                                    ) const
+    {
+        auto const bom_size = this->get_bom().first;
+        auto const bom_chars = this->get_bom().second;
+        if (bom_chars && in_size >= bom_size)
+            // skip bom chars
+        {
+            auto p_bytes = bytes;
+            for (auto p_bom = bom_chars
+                 ; p_bom < bom_chars + bom_size
+                 ; ++p_bom, ++p_bytes)
+            {
+                if (*p_bom != static_cast<decltype(*p_bom)>(*p_bytes))
+                {
+                    break;
+                }
+            }
+            if (static_cast<std::size_t>(p_bytes - bytes) == bom_size)
+            {
+                bytes   += bom_size;
+                in_size -= bom_size;
+            }
+        }
+
+        std::size_t invalid = 0;
+        wchar_t* out = nullptr;
+        for (out_size = 0; !out && in_size; )
+            // exit if in_size == 0
+        {
+            if (out_size != 0)
+            {
+                out = allocator(out_size);
+            }
+            else if (out_size == 0)
+                // calculate out buffer size.
+            {
+                // perhaps too large, but that's OK
+                CONSTEXPR auto ratio = 3;
+                out_size = in_size * ratio;
+                continue ;
+            }
+
+            if (this->cp_ == codepage::cp_default)
+                // ANSI to Unicode
+            {
+                typedef char from_type;
+                typedef wchar_t to_type;
+                typedef std::codecvt<to_type
+                                     , from_type, std::mbstate_t> cvt_facet;
+
+                std::locale loc("");
+                auto& cvt = std::use_facet<cvt_facet>(loc);
+
+                basic_newline_filter<to_type> filter(this->nl_);
+
+                from_type const* fn = bytes;
+                from_type const* fe = bytes + in_size;
+                std::size_t done = 0;
+                std::mbstate_t state = std::mbstate_t();
+                progress_meter meter;
+                while (fn != fe)
+                {
+                    meter(static_cast<std::size_t>(fn - bytes));
+                    from_type const* fb = fn;
+                    from_type const* ce = (fe - fn > g_chunk_size)
+                        ? fn + g_chunk_size : fe;
+
+                    to_type* tb = const_cast<to_type*>(out + done);
+                    to_type* te = const_cast<to_type*>(out + out_size);
+                    to_type* tn = nullptr;
+
+                    auto result = cvt.in(state, fb, ce, fn, tb, te, tn);
+                    auto const full = (tn == te);
+                    done = static_cast<std::size_t>(filter(tb, tn) - out);
+                    if (result == cvt_facet::ok || result == cvt_facet::noconv)
+                    {
+                        continue;
+                    }
+                    else if (result == cvt_facet::partial && full)
+                    {
+                        stats_add(this->cp_, stats::wide, stats::regrowths);
+                        out_size += BUFSIZ;
+                        out = allocator(out_size);
+                        continue;
+                    }
+                    else if (result == cvt_facet::partial && ce != fe)
+                        // incomplete sequence at the end of chunk.
+                    {
+                        continue;
+                    }
+
+                    // failed, or incomplete sequence at the end if partial.
+                    if (this->po_ == policy::strict)
+                    {
+                        throw std::system_error(
+                            std::make_error_code(
+                                std::errc::illegal_byte_sequence)
+                            , "std::codecvt for decode");
+                    }
+
+                    ++invalid;
+                    if (this->po_ == policy::stop)
+                    {
+                        break;
+                    }
+                    if (this->po_ == policy::replace)
+                    {
+                        if (done == out_size)
+                        {
+                            out_size += BUFSIZ;
+                            out = allocator(out_size);
+                        }
+                        out[done] = static_cast<to_type>(0xFFFD);
+                        done = static_cast<std::size_t>(
+                            filter(out + done, out + done + 1) - out);
+                    }
+                    fn = (result == cvt_facet::partial) ? fe : fn + 1;
+                    state = std::mbstate_t();
+                }
+                meter.finish(static_cast<std::size_t>(fn - bytes));
+                out_size = done;
+                return invalid;
+            }
+
+            auto const cd = descriptor(false);
+
+            // iconv
+            char* inbuf = (char*)bytes;
+            char* const inend = inbuf + in_size;
+            char* outbuf = (char*)out;
+            size_t outbytesleft = out_size * sizeof(wchar_t);
+
+            // outbuf is too small, increment its size.
+            auto grow = [&]()
+            {
+                stats_add(this->cp_, stats::wide, stats::regrowths);
+                outbuf = (char*)allocator(out_size + BUFSIZ);
+                outbuf += (out_size * sizeof(wchar_t) - outbytesleft);
+                outbytesleft += BUFSIZ * sizeof(wchar_t);
+                out_size += BUFSIZ;
+            };
+
+            // normalize output since last flush in place.
+            basic_newline_filter<wchar_t> filter(this->nl_);
+            std::size_t flushed = 0;
+            auto flush = [&]()
+            {
+                auto const written = out_size
+                    - outbytesleft / sizeof(wchar_t);
+                auto const base = (wchar_t*)outbuf - written;
+                auto const last = filter(base + flushed, base + written);
+                flushed = static_cast<std::size_t>(last - base);
+                outbytesleft += (written - flushed) * sizeof(wchar_t);
+                outbuf = (char*)last;
+            };
+
+            progress_meter meter;
+            for ( ; ; flush())
+            {
+                // chunk by chunk.
+                meter(static_cast<std::size_t>(inbuf - bytes));
+                size_t inbytesleft = (std::min)(
+                    static_cast<size_t>(inend - inbuf)
+                    , static_cast<size_t>(g_chunk_size));
+                auto const chunk_end = inbuf + inbytesleft;
+
+                auto rv = ::iconv(cd
+                                  , &inbuf, &inbytesleft
+                                  , &outbuf, &outbytesleft);
+                if (rv != static_cast<size_t>(-1))
+                {
+                    if (inbuf == inend)
+                    {
+                        break;
+                    }
+                    continue;
+                }
+
+                auto const err = errno;
+                if (err == E2BIG)
+                {
+                    grow();
+                    continue;
+                }
+
+                if (err == EINVAL && chunk_end != inend)
+                    // incomplete sequence at the end of chunk.
+                {
+                    continue;
+                }
+
+                if ((err == EILSEQ || err == EINVAL)
+                    && this->po_ != policy::strict)
+                    // invalid sequence, or incomplete one at the end.
+                {
+                    ++invalid;
+                    if (this->po_ == policy::stop)
+                    {
+                        break;
+                    }
+                    if (this->po_ == policy::replace)
+                    {
+                        if (outbytesleft < sizeof(wchar_t))
+                        {
+                            grow();
+                        }
+                        wchar_t const rc = static_cast<wchar_t>(0xFFFD);
+                        std::memcpy(outbuf, &rc, sizeof(rc));
+                        outbuf += sizeof(rc);
+                        outbytesleft -= sizeof(rc);
+                    }
+                    auto const left = static_cast<size_t>(inend - inbuf);
+                    inbuf += (err == EINVAL) ? left
+                        : (std::min)(left, this->unit_size());
+                    if (inbuf == inend)
+                    {
+                        break;
+                    }
+                    continue;
+                }
+
+                throw std::system_error(
+                    std::error_code(err, std::system_category())
+                    , "iconv for decode");
+            }
+            flush();
+            meter.finish(static_cast<std::size_t>(inbuf - bytes));
+            out_size -= outbytesleft / sizeof(wchar_t);
+        }
+        return invalid;
+    }
+
+private:
+    // open the descriptor on first use and reset its state, the instance
+    // reuses it for later calls (e.g. blocks of transcoding_streambuf).
+    iconv_t descriptor(bool encoding) const
+    {
+        auto& cd = encoding ? en_ : de_;
+        if (!cd)
+        {
+            auto const h = encoding
+                ? ::iconv_open(to_iconv_codepage(this->cp_).c_str()
+                               , default_wide_charset().c_str())
+                : ::iconv_open(default_wide_charset().c_str()
+                               , to_iconv_codepage(this->cp_).c_str());
+            if (h == (iconv_t)(-1))
+            {
+                throw std::system_error(
+                    std::error_code(errno, std::system_category())
+                    , encoding ? "iconv_open for encode"
+                               : "iconv_open for decode");
+            }
+            if (encoding)
+            {
+                stats_add(stats::wide, this->cp_, stats::iconv_opens);
+            }
+            else
+            {
+                stats_add(this->cp_, stats::wide, stats::iconv_opens);
+            }
+            cd.reset(h, [](iconv_t h) { ::iconv_close(h); });
+        }
+        auto const h = static_cast<iconv_t>(cd.get());
+        ::iconv(h, nullptr, nullptr, nullptr, nullptr);
+        return h;
+    }
+
+    // U+FFFD in target codepage, or '?' if it can't be encoded.
+    static std::string default_replacement(iconv_t cd)
+    {
+        wchar_t rc = static_cast<wchar_t>(0xFFFD);
+        char* inbuf = (char*)&rc;
+        size_t inbytesleft = sizeof(rc);
+
+        char buf[16];
+        char* outbuf = buf;
+        size_t outbytesleft = sizeof(buf);
+
+        auto rv = ::iconv(cd, &inbuf, &inbytesleft, &outbuf, &outbytesleft);
+        if (rv == static_cast<size_t>(-1))
+        {
+            return std::string(1, '?');
+        }
+        return std::string(buf, outbuf);
+    }
+
+private:
+    // not shared, an instance is used by one thread at a time.
+    mutable std::shared_ptr<void> en_;
+    mutable std::shared_ptr<void> de_;
+};
+
+} // namespace detail
+
+#endif // YMH_UNA_WITH_ICONV
+
+/*****************************************************************************/
+/* Native Implement. */
+
+namespace detail
+{
+
+CONSTEXPR char32_t g_bad_codepoint = 0xFFFD;
+
+// decode one UTF-8 character, return its length; malformed, overlong,
+// surrogate or truncated sequences are one byte of U+FFFD.
+inline std::size_t next_utf8(unsigned char const* first
+                             , unsigned char const* last, char32_t& c)
+{
+    auto const lead = *first;
+    std::size_t n = 0;
+    char32_t min = 0;
+    if (lead < 0xC2 || lead > 0xF4)
+    {
+        c = g_bad_codepoint;
+        return 1;
+    }
+    else if (lead < 0xE0)
+    {
+        n = 2; min = 0x80; c = lead & 0x1F;
+    }
+    else if (lead < 0xF0)
+    {
+        n = 3; min = 0x800; c = lead & 0x0F;
+    }
+    else
+    {
+        n = 4; min = 0x10000; c = lead & 0x07;
+    }
+
+    if (static_cast<std::size_t>(last - first) < n)
+    {
+        c = g_bad_codepoint;
+        return 1;
+    }
+    for (std::size_t i = 1; i != n; ++i)
+    {
+        if ((first[i] & 0xC0) != 0x80)
+        {
+            c = g_bad_codepoint;
+            return 1;
+        }
+        c = (c << 6) | (first[i] & 0x3F);
+    }
+    if (c < min || c > 0x10FFFF || (0xD800 <= c && c <= 0xDFFF))
+    {
+        c = g_bad_codepoint;
+        return 1;
+    }
+    return n;
+}
+
+// Latin-1 bytes to wchar_t, every byte is a character.
+inline void widen_latin1(unsigned char const* p, std::size_t n, wchar_t* q)
+{
+    std::size_t i = 0;
+#if defined(YMH_UNA_WITH_AVX2)
+    for ( ; n - i >= 16; i += 16)
+    {
+        auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+        if (sizeof(wchar_t) == 2)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(q + i)
+                                , _mm256_cvtepu8_epi16(v));
+            continue;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(q + i)
+                            , _mm256_cvtepu8_epi32(v));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(q + i + 8)
+                            , _mm256_cvtepu8_epi32(_mm_srli_si128(v, 8)));
+    }
+#elif defined(YMH_UNA_WITH_SSE2)
+    auto const zero = _mm_setzero_si128();
+    for ( ; n - i >= 16; i += 16)
+    {
+        auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+        __m128i w[4] = { _mm_unpacklo_epi8(v, zero)
+                         , _mm_unpackhi_epi8(v, zero) };
+        if (sizeof(wchar_t) != 2)
+        {
+            w[3] = _mm_unpackhi_epi16(w[1], zero);
+            w[2] = _mm_unpacklo_epi16(w[1], zero);
+            w[1] = _mm_unpackhi_epi16(w[0], zero);
+            w[0] = _mm_unpacklo_epi16(w[0], zero);
+        }
+        for (std::size_t k = 0; k != sizeof(wchar_t); ++k)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(q + i) + k, w[k]);
+        }
+    }
+#endif  // YMH_UNA_WITH_AVX2
+    for ( ; i != n; ++i)
+    {
+        q[i] = static_cast<wchar_t>(p[i]);
+    }
+}
+
+// wchar_t to Latin-1 bytes, return the number of leading characters done,
+// it stops before the first one above U+00FF.
+inline std::size_t narrow_latin1(wchar_t const* w, std::size_t n
+                                 , unsigned char* q)
+{
+    std::size_t i = 0;
+#if defined(YMH_UNA_WITH_AVX2)
+    auto const high = (sizeof(wchar_t) == 2) ? _mm256_set1_epi16(-256)
+                                             : _mm256_set1_epi32(-256);
+    for ( ; n - i >= 16; i += 16)
+    {
+        auto const a = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const*>(w + i));
+        if (sizeof(wchar_t) == 2)
+        {
+            if (!_mm256_testz_si256(a, high))
+            {
+                break;
+            }
+            auto const r = _mm_packus_epi16(_mm256_castsi256_si128(a)
+                                            , _mm256_extracti128_si256(a, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(q + i), r);
+            continue;
+        }
+        auto const b = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const*>(w + i + 8));
+        if (!_mm256_testz_si256(_mm256_or_si256(a, b), high))
+        {
+            break;
+        }
+        // packus works in 128 bits lanes, restore order of 64 bits.
+        auto const s = _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b)
+                                                , 0xD8);
+        auto const r = _mm_packus_epi16(_mm256_castsi256_si128(s)
+                                        , _mm256_extracti128_si256(s, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(q + i), r);
+    }
+#elif defined(YMH_UNA_WITH_SSE2)
+    auto const zero = _mm_setzero_si128();
+    auto const high = (sizeof(wchar_t) == 2) ? _mm_set1_epi16(-256)
+                                             : _mm_set1_epi32(-256);
+    for ( ; n - i >= 16; i += 16)
+    {
+        auto const v = reinterpret_cast<__m128i const*>(w + i);
+        __m128i s[2];
+        if (sizeof(wchar_t) == 2)
+        {
+            s[0] = _mm_loadu_si128(v);
+            s[1] = _mm_loadu_si128(v + 1);
+        }
+        else
+        {
+            // no unsigned saturation of 32 bits, values are checked.
+            s[0] = _mm_packs_epi32(_mm_loadu_si128(v), _mm_loadu_si128(v + 1));
+            s[1] = _mm_packs_epi32(_mm_loadu_si128(v + 2)
+                                   , _mm_loadu_si128(v + 3));
+            auto const all = _mm_or_si128(
+                _mm_or_si128(_mm_loadu_si128(v), _mm_loadu_si128(v + 1))
+                , _mm_or_si128(_mm_loadu_si128(v + 2)
+                               , _mm_loadu_si128(v + 3)));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(all, high)
+                                                 , zero)) != 0xFFFF)
+            {
+                break;
+            }
+        }
+        if (sizeof(wchar_t) == 2
+            && _mm_movemask_epi8(_mm_cmpeq_epi8(
+                   _mm_and_si128(_mm_or_si128(s[0], s[1]), high), zero))
+               != 0xFFFF)
+        {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(q + i)
+                         , _mm_packus_epi16(s[0], s[1]));
+    }
+#endif  // YMH_UNA_WITH_AVX2
+    for ( ; i != n; ++i)
+    {
+        auto const c = static_cast<std::uint32_t>(w[i]);
+        if (c > 0xFF)
+        {
+            break;
+        }
+        q[i] = static_cast<unsigned char>(c);
+    }
+    return i;
+}
+
+//
+// UTF-8, UCS-2 and Latin-1 without platform API, registered as backend
+// "native", it's preferred for Latin-1.
+//
+// Invalid sequences are handled as iconv_impl does: one per byte (per unit
+// for UCS-2), and a truncated sequence at the end is one.
+//
+class native_impl : public codec_impl
+{
+public:
+    native_impl(codepage::type cp, bom::type bo
+                , policy::type po = policy::strict
+                , std::string const& replacement = std::string()
+                , normalize::type nl = normalize::none)
+        : codec_impl(cp, bo, po, replacement, nl)
+    {}
+
+    static bool supports(codepage::type cp)
+    {
+        using namespace codepage;
+        return cp == cp_utf8 || cp == cp_ucs2_le || cp == cp_ucs2_be
+            || cp == cp_latin1;
+    }
+
+    virtual std::size_t encode_impl(wchar_t const* wstr
+                                    , std::size_t in_size, std::size_t& out_size
+                                    , codec_impl::alloc4en_t const& allocator
+                                    ) const
+    {
+        auto const bom_size = this->get_bom().first;
+        auto const bom_chars = this->get_bom().second;
+
+        auto const latin1 = (this->cp_ == codepage::cp_latin1);
+        std::string repl = this->replacement_;
+        if (repl.empty() && latin1)
+            // U+FFFD can't be encoded, as iconv.
+        {
+            repl = "?";
+        }
+        else if (repl.empty())
+        {
+            char buf[4];
+            repl.assign(buf, put(0xFFFD, buf));
+        }
+
+        // UTF-8 takes 4 bytes for one character (or surrogate pair) at most.
+        auto const unit = (std::max)(
+            static_cast<std::size_t>(latin1 ? 1
+                                     : this->unit_size() == 1 ? 4 : 2)
+            , repl.size());
+        auto const out = allocator(bom_size + in_size * unit);
+        auto p = std::copy(bom_chars, bom_chars + bom_size, out);
+        if (!in_size)
+            // fill BOM if in_size == 0, then exit.
+        {
+            out_size = 0;
+            return 0;
+        }
+
+        auto const max = latin1 ? 0xFF
+            : (this->unit_size() == 1) ? 0x10FFFF : 0xFFFF;
+        std::size_t invalid = 0;
+        progress_meter meter(sizeof(wchar_t));
+        for (std::size_t i = 0; i != in_size; )
+        {
+            meter(i);
+            if (latin1)
+                // run of Latin-1 characters at once, chunk by chunk.
+            {
+                auto const m = (std::min)(in_size - i
+                                          , std::size_t(g_chunk_size));
+                auto const n = narrow_latin1(
+                    wstr + i, m, reinterpret_cast<unsigned char*>(p));
+                p += n;
+                i += n;
+                if (n == m)
+                {
+                    continue;
+                }
+            }
+
+            auto c = static_cast<char32_t>(wstr[i++]);
+            if (sizeof(wchar_t) == 2 && 0xD800 <= c && c <= 0xDBFF
+                && i != in_size && 0xDC00 <= static_cast<char32_t>(wstr[i])
+                && static_cast<char32_t>(wstr[i]) <= 0xDFFF)
+                // surrogate pair
+            {
+                c = 0x10000 + ((c - 0xD800) << 10)
+                    + (static_cast<char32_t>(wstr[i++]) - 0xDC00);
+            }
+            if (c <= static_cast<char32_t>(max)
+                && (c < 0xD800 || 0xDFFF < c))
+            {
+                p = put(c, p);
+                continue;
+            }
+
+            if (this->po_ == policy::strict)
+            {
+                throw std::system_error(
+                    std::make_error_code(std::errc::illegal_byte_sequence)
+                    , "native encode");
+            }
+            ++invalid;
+            if (this->po_ == policy::stop)
+            {
+                break;
+            }
+            if (this->po_ == policy::replace)
+            {
+                p = std::copy(repl.begin(), repl.end(), p);
+            }
+        }
+        meter.finish(in_size);
+        out_size = static_cast<std::size_t>(p - out);
+        return invalid;
+    }
+
+    virtual std::size_t decode_impl(char const* bytes
+                                    , std::size_t in_size, std::size_t& out_size
+                                    , codec_impl::alloc4de_t const& allocator
+                                    ) const
+    {
+        auto const bom_size = this->get_bom().first;
+        auto const bom_chars = this->get_bom().second;
+        if (bom_chars && in_size >= bom_size
+            && std::equal(bom_chars, bom_chars + bom_size
+                          , reinterpret_cast<unsigned char const*>(bytes)))
+            // skip bom chars
+        {
+            bytes   += bom_size;
+            in_size -= bom_size;
+        }
+
+        out_size = 0;
+        if (!in_size)
+        {
+            return 0;
+        }
+
+        // one unit per byte at most.
+        auto const out = allocator(in_size);
+        auto q = out;
+        auto p = reinterpret_cast<unsigned char const*>(bytes);
+        auto const last = p + in_size;
+
+        progress_meter meter;
+        if (this->cp_ == codepage::cp_latin1)
+            // always valid, chunk by chunk.
+        {
+            for (std::size_t i = 0; i != in_size; )
+            {
+                meter(i);
+                auto const m = (std::min)(in_size - i
+                                          , std::size_t(g_chunk_size));
+                widen_latin1(p + i, m, q + i);
+                i += m;
+            }
+            q += in_size;
+            p = last;
+        }
+
+        std::size_t invalid = 0;
+        auto const first = p;
+        while (p != last)
+        {
+            meter(static_cast<std::size_t>(p - first));
+            char32_t c = 0;
+            std::size_t n = 0;  // bytes of valid character
+            if (this->cp_ == codepage::cp_utf8)
+            {
+                n = (*p < 0x80) ? (c = *p, 1) : next_utf8(p, last, c);
+                n = (n == 1 && *p >= 0x80) ? 0 : n;
+            }
+            else if (last - p >= 2)
+            {
+                c = (this->cp_ == codepage::cp_ucs2_le) ? (p[1] << 8 | p[0])
+                                                        : (p[0] << 8 | p[1]);
+                n = (0xD800 <= c && c <= 0xDFFF) ? 0 : 2;
+            }
+
+            if (n)
+            {
+                q = put(c, q);
+                p += n;
+                continue;
+            }
+
+            auto const cut = truncated(p, last);
+            if (this->po_ == policy::strict)
+                // same error as iconv
+            {
+                throw std::system_error(
+                    std::make_error_code(cut ? std::errc::invalid_argument
+                                         : std::errc::illegal_byte_sequence)
+                    , "native decode");
+            }
+            ++invalid;
+            if (this->po_ == policy::stop)
+            {
+                break;
+            }
+            if (this->po_ == policy::replace)
+            {
+                *q++ = static_cast<wchar_t>(0xFFFD);
+            }
+            p = cut ? last
+                : p + (std::min)(this->unit_size()
+                                 , static_cast<std::size_t>(last - p));
+        }
+        meter.finish(in_size);
+        out_size = static_cast<std::size_t>(q - out);
+
+        basic_newline_filter<wchar_t> filter(this->nl_);
+        if (filter)
+        {
+            out_size = static_cast<std::size_t>(
+                filter(out, out + out_size) - out);
+        }
+        return invalid;
+    }
+
+private:
+    char* put(char32_t c, char* p) const
+    {
+        using namespace codepage;
+        if (this->cp_ == cp_latin1)
+        {
+            *p++ = static_cast<char>(c);
+            return p;
+        }
+        if (this->cp_ == cp_ucs2_le || this->cp_ == cp_ucs2_be)
+        {
+            auto const hi = static_cast<char>(c >> 8);
+            auto const lo = static_cast<char>(c & 0xFF);
+            *p++ = (this->cp_ == cp_ucs2_le) ? lo : hi;
+            *p++ = (this->cp_ == cp_ucs2_le) ? hi : lo;
+            return p;
+        }
+
+        if (c < 0x80)
+        {
+            *p++ = static_cast<char>(c);
+        }
+        else if (c < 0x800)
+        {
+            *p++ = static_cast<char>(0xC0 | (c >> 6));
+            *p++ = static_cast<char>(0x80 | (c & 0x3F));
+        }
+        else if (c < 0x10000)
+        {
+            *p++ = static_cast<char>(0xE0 | (c >> 12));
+            *p++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            *p++ = static_cast<char>(0x80 | (c & 0x3F));
+        }
+        else
+        {
+            *p++ = static_cast<char>(0xF0 | (c >> 18));
+            *p++ = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            *p++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            *p++ = static_cast<char>(0x80 | (c & 0x3F));
+        }
+        return p;
+    }
+
+    static wchar_t* put(char32_t c, wchar_t* q)
+    {
+        if (sizeof(wchar_t) == 2 && c > 0xFFFF)
+            // surrogate pair
+        {
+            *q++ = static_cast<wchar_t>(0xD800 + ((c - 0x10000) >> 10));
+            *q++ = static_cast<wchar_t>(0xDC00 + ((c - 0x10000) & 0x3FF));
+            return q;
+        }
+        *q++ = static_cast<wchar_t>(c);
+        return q;
+    }
+
+    // prefix of a valid sequence which is cut by the end.
+    bool truncated(unsigned char const* p, unsigned char const* last) const
+    {
+        if (this->cp_ != codepage::cp_utf8)
+        {
+            return last - p < 2;
+        }
+
+        auto const lead = *p;
+        auto const n = (lead >= 0xF0) ? 4 : (lead >= 0xE0) ? 3 : 2;
+        if (lead < 0xC2 || lead > 0xF4 || last - p >= n)
+        {
+            return false;
+        }
+        for (auto q = p + 1; q != last; ++q)
+        {
+            if ((*q & 0xC0) != 0x80)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace detail
+
+/*****************************************************************************/
+/* Lookup Table Implement. */
+
+//
+// Define YMH_UNA_WITH_TABLES before include una.hpp to convert single and
+// double byte codepages, GB2312 and the locale's one, by lookup tables.
+//
+// A table is probed from iconv once per codepage, then saved to a file of
+// tables::directory() which later processes map into memory. Codepages of
+// longer or stateful sequences (UTF-8, GB18030, ...) are left to iconv.
+//
+#if defined(YMH_UNA_WITH_TABLES) && defined(YMH_UNA_WITH_ICONV)
+
+namespace detail
+{
+
+// layout of table file, native byte order.
+struct code_table
+{
+    enum kind_type { bad_byte, single_byte, lead_byte };
+
+    char magic[8];                      // "UNATBL1"
+    std::uint32_t order;                // 0x01020304
+    std::uint32_t reserved;
+    char charset[48];
+    unsigned char kind[256];            // of the first byte
+    std::uint16_t single[256];          // character of single byte
+    std::uint16_t pair[256 * 256];      // of lead << 8 | trail, 0 if invalid
+    std::uint16_t encoded[256 * 256];   // double byte if > 0xFF, 0 if none
+};
+
+CONSTEXPR char g_table_magic[] = "UNATBL1";
+CONSTEXPR std::uint32_t g_table_order = 0x01020304;
+
+// convert one sequence by itself, err is errno if failed.
+//
+// Output held back for the next input (combining, shift state) isn't
+// flushed, so such codepages fail to probe.
+inline std::size_t probe_iconv(iconv_t cd, char const* in, std::size_t in_size
+                               , char* out, std::size_t out_size, int& err)
+{
+    ::iconv(cd, nullptr, nullptr, nullptr, nullptr);
+
+    char* inbuf = const_cast<char*>(in);
+    size_t inbytesleft = in_size;
+    char* outbuf = out;
+    size_t outbytesleft = out_size;
+
+    auto const rv = ::iconv(cd, &inbuf, &inbytesleft, &outbuf, &outbytesleft);
+    err = (rv == static_cast<size_t>(-1)) ? errno : 0;
+    return static_cast<std::size_t>(outbuf - out);
+}
+
+// false if charset isn't single or double byte, or beyond BMP.
+inline bool probe_code_table(std::string const& charset, code_table& t)
+{
+    std::memset(&t, 0, sizeof(t));
+    std::memcpy(t.magic, g_table_magic, sizeof(t.magic));
+    t.order = g_table_order;
+    if (charset.empty() || charset.size() >= sizeof(t.charset))
+    {
+        return false;
+    }
+    std::memcpy(t.charset, charset.data(), charset.size());
+
+    auto const wide = default_wide_charset();
+    auto const de = ::iconv_open(wide.c_str(), charset.c_str());
+    if (de == (iconv_t)(-1))
+    {
+        return false;
+    }
+    auto const en = ::iconv_open(charset.c_str(), wide.c_str());
+    if (en == (iconv_t)(-1))
+    {
+        ::iconv_close(de);
+        return false;
+    }
+
+    auto ok = true;
+    int err = 0;
+    wchar_t w[4] = {};
+    char in[2];
+
+    // one character of one byte, or incomplete if lead byte.
+    for (int b = 0; ok && b != 256; ++b)
+    {
+        in[0] = static_cast<char>(b);
+        auto const n = probe_iconv(de, in, 1, (char*)w, sizeof(w), err);
+        auto const c = static_cast<std::uint32_t>(w[0]);
+        if (!err && n == sizeof(wchar_t) && c <= 0xFFFF)
+        {
+            t.kind[b] = code_table::single_byte;
+            t.single[b] = static_cast<std::uint16_t>(c);
+        }
+        else if (err == EINVAL && !n)
+        {
+            t.kind[b] = code_table::lead_byte;
+        }
+        else
+        {
+            ok = (err == EILSEQ);
+        }
+    }
+
+    for (int b = 0; ok && b != 256; ++b)
+    {
+        if (t.kind[b] != code_table::lead_byte)
+        {
+            continue;
+        }
+        in[0] = static_cast<char>(b);
+        for (int trail = 0; ok && trail != 256; ++trail)
+        {
+            in[1] = static_cast<char>(trail);
+            auto const n = probe_iconv(de, in, 2, (char*)w, sizeof(w), err);
+            auto const c = static_cast<std::uint32_t>(w[0]);
+            if (!err && n == sizeof(wchar_t) && 0 < c && c <= 0xFFFF)
+            {
+                t.pair[b << 8 | trail] = static_cast<std::uint16_t>(c);
+            }
+            else
+            {
+                ok = (err == EILSEQ);
+            }
+        }
+    }
+
+    // one or two bytes of every character in BMP.
+    char o[8];
+    for (std::uint32_t c = 0; ok && c != 0x10000; ++c)
+    {
+        if (0xD800 <= c && c <= 0xDFFF)
+        {
+            continue;
+        }
+        auto const wc = static_cast<wchar_t>(c);
+        auto const n = probe_iconv(en, (char const*)&wc, sizeof(wc)
+                                   , o, sizeof(o), err);
+        auto const b0 = static_cast<unsigned char>(o[0]);
+        auto const b1 = static_cast<unsigned char>(o[1]);
+        if (err == EILSEQ)
+        {
+            continue;
+        }
+        else if (err || !n || n > 2 || !b0 != !c
+                 || t.kind[b0] != ((n == 1) ? code_table::single_byte
+                                            : code_table::lead_byte))
+            // decoding doesn't take it back.
+        {
+            ok = false;
+        }
+        else
+        {
+            t.encoded[c] = static_cast<std::uint16_t>(
+                (n == 1) ? b0 : (b0 << 8 | b1));
+        }
+    }
+
+    ::iconv_close(en);
+    ::iconv_close(de);
+    return ok;
+}
+
+// loaded tables by charset, null if it isn't single or double byte.
+class table_store
+{
+public:
+    typedef std::shared_ptr<code_table const> table_ptr;
+
+    static table_store& instance()
+    {
+        static table_store store;
+        return store;
+    }
+
+    std::string directory()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return directory_;
+    }
+
+    void set_directory(std::string const& dir)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        directory_ = dir;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tables_.clear();
+    }
+
+    table_ptr find(codepage::type cp)
+    {
+        auto const charset = to_charset(cp);
+        if (charset.empty())
+        {
+            return table_ptr();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto const& e : tables_)
+        {
+            if (e.first == charset)
+            {
+                return e.second;
+            }
+        }
+
+        auto const path = to_path(charset);
+        auto t = load(path, charset);
+        if (!t)
+        {
+            std::unique_ptr<code_table> built(new code_table);
+            if (probe_code_table(charset, *built))
+            {
+                t = save(path, *built) ? load(path, charset) : table_ptr();
+                t = t ? t : table_ptr(built.release());
+            }
+        }
+        tables_.push_back(std::make_pair(charset, t));
+        return t;
+    }
+
+private:
+    table_store()
+        : directory_(user_cache_directory())
+    {}
+
+    // empty if codepage can't be told.
+    static std::string to_charset(codepage::type cp)
+    {
+        if (cp != codepage::cp_default)
+        {
+            return to_iconv_codepage(cp);
+        }
+
+        std::string name;
+        try
+        {
+            name = std::locale("").name();
+        }
+        catch (std::exception const&)
+        {
+            return std::string();
+        }
+        auto const bp = name.find('.');
+        if (bp == std::string::npos || name.find(';') != std::string::npos)
+            // "C", or mixed categories.
+        {
+            return std::string();
+        }
+        return name.substr(bp + 1, name.find('@', bp) - bp - 1);
+    }
+
+    // empty if not saved.
+    std::string to_path(std::string const& charset) const
+    {
+        if (directory_.empty())
+        {
+            return std::string();
+        }
+        std::string file = "una-" + charset + ".tbl";
+        for (auto& ch : file)
+        {
+            if (!std::isalnum(static_cast<unsigned char>(ch))
+                && ch != '-' && ch != '_' && ch != '.')
+            {
+                ch = '_';
+            }
+        }
+        return directory_ + "/" + file;
+    }
+
+    static table_ptr load(std::string const& path, std::string const& charset)
+    {
+        if (path.empty())
+        {
+            return table_ptr();
+        }
+        auto const fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            return table_ptr();
+        }
+
+        struct stat st;
+        void* addr = MAP_FAILED;
+        if (::fstat(fd, &st) == 0 && st.st_size == sizeof(code_table))
+        {
+            addr = ::mmap(nullptr, sizeof(code_table), PROT_READ, MAP_SHARED
+                          , fd, 0);
+        }
+        ::close(fd);
+        if (addr == MAP_FAILED)
+        {
+            return table_ptr();
+        }
+
+        table_ptr t(static_cast<code_table const*>(addr)
+                    , [](code_table const* p)
+        {
+            ::munmap(const_cast<code_table*>(p), sizeof(code_table));
+        });
+        if (std::memcmp(t->magic, g_table_magic, sizeof(t->magic))
+            || t->order != g_table_order
+            || charset != t->charset)
+            // stale or foreign file, probe again.
+        {
+            return table_ptr();
+        }
+        return t;
+    }
+
+    // write temporary file and rename, readers never see a partial one.
+    bool save(std::string const& path, code_table const& t) const
+    {
+        if (path.empty())
+        {
+            return false;
+        }
+        ::mkdir(directory_.c_str(), 0700);
+
+        auto const tmp = path + "." + std::to_string(::getpid()) + ".tmp";
+        {
+            std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+            ofs.write(reinterpret_cast<char const*>(&t), sizeof(t));
+            if (!ofs.flush())
+            {
+                ofs.close();
+                std::remove(tmp.c_str());
+                return false;
+            }
+        }
+        if (std::rename(tmp.c_str(), path.c_str()) != 0)
+        {
+            std::remove(tmp.c_str());
+            return false;
+        }
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    std::string directory_;
+    std::vector<std::pair<std::string, table_ptr> > tables_;
+};
+
+//
+// Single and double byte codepages by lookup, registered as backend "table".
+//
+// Invalid sequences are handled as iconv_impl does, they are probed from it.
+//
+class table_impl : public codec_impl
+{
+public:
+    table_impl(table_store::table_ptr const& table
+               , codepage::type cp, bom::type bo
+               , policy::type po = policy::strict
+               , std::string const& replacement = std::string()
+               , normalize::type nl = normalize::none)
+        : codec_impl(cp, bo, po, replacement, nl), table_(table)
+    {}
+
+    static bool supports(codepage::type cp)
+    {
+        using namespace codepage;
+        return cp == cp_default || cp == cp_gb2312;
+    }
+
+    // iconv_impl if cp isn't single or double byte.
+    static std::shared_ptr<codec_impl>
+    create(codepage::type cp, bom::type bo, policy::type po
+           , std::string const& replacement, normalize::type nl)
+    {
+        auto const t = table_store::instance().find(cp);
+        if (!t)
+        {
+            return std::make_shared<iconv_impl>(cp, bo, po, replacement, nl);
+        }
+        return std::make_shared<table_impl>(t, cp, bo, po, replacement, nl);
+    }
+
+    // single and double byte codepages have no BOM.
+    virtual std::size_t encode_impl(wchar_t const* wstr
+                                    , std::size_t in_size, std::size_t& out_size
+                                    , codec_impl::alloc4en_t const& allocator
+                                    ) const
+    {
+        auto const& t = *table_;
+
+        std::string repl = this->replacement_;
+        if (repl.empty())
+            // U+FFFD as iconv_impl, '?' for locale's one as std::codecvt.
+        {
+            auto const rc = t.encoded[0xFFFD];
+            repl = (this->cp_ == codepage::cp_default || !rc)
+                ? std::string(1, '?') : (rc > 0xFF)
+                ? std::string{ static_cast<char>(rc >> 8)
+                               , static_cast<char>(rc & 0xFF) }
+                : std::string(1, static_cast<char>(rc));
+        }
+
+        out_size = 0;
+        if (!in_size)
+        {
+            return 0;
+        }
+
+        auto const out = allocator(
+            in_size * (std::max)(static_cast<std::size_t>(2), repl.size()));
+        auto p = out;
+
+        std::size_t invalid = 0;
+        progress_meter meter(sizeof(wchar_t));
+        for (std::size_t i = 0; i != in_size; ++i)
+        {
+            meter(i);
+            auto const c = static_cast<std::uint32_t>(wstr[i]);
+            auto const b = (c <= 0xFFFF) ? t.encoded[c] : 0;
+            if (b > 0xFF)
+            {
+                *p++ = static_cast<char>(b >> 8);
+                *p++ = static_cast<char>(b & 0xFF);
+                continue;
+            }
+            else if (b || !c)
+            {
+                *p++ = static_cast<char>(b);
+                continue;
+            }
+
+            if (this->po_ == policy::strict)
+            {
+                throw std::system_error(
+                    std::make_error_code(std::errc::illegal_byte_sequence)
+                    , "table encode");
+            }
+            ++invalid;
+            if (this->po_ == policy::stop)
+            {
+                break;
+            }
+            if (this->po_ == policy::replace)
+            {
+                p = std::copy(repl.begin(), repl.end(), p);
+            }
+        }
+        meter.finish(in_size);
+        out_size = static_cast<std::size_t>(p - out);
+        return invalid;
+    }
+
+    virtual std::size_t decode_impl(char const* bytes
+                                    , std::size_t in_size, std::size_t& out_size
+                                    , codec_impl::alloc4de_t const& allocator
+                                    ) const
+    {
+        auto const& t = *table_;
+
+        out_size = 0;
+        if (!in_size)
+        {
+            return 0;
+        }
+
+        // one character per byte at most.
+        auto const out = allocator(in_size);
+        auto q = out;
+        auto p = reinterpret_cast<unsigned char const*>(bytes);
+        auto const last = p + in_size;
+
+        CONSTEXPR std::ptrdiff_t block = 64;
+        auto fast = true;
+        std::size_t invalid = 0;
+        progress_meter meter;
+        while (p != last)
+        {
+            meter(static_cast<std::size_t>(p - (last - in_size)));
+            auto const end = (last - p > block) ? p + block : last;
+            if (fast)
+                // lookup block as single bytes, branch free.
+            {
+                unsigned bad = 0;
+                auto const n = end - p;
+                for (std::ptrdiff_t i = 0; i != n; ++i)
+                {
+                    q[i] = static_cast<wchar_t>(t.single[p[i]]);
+                    bad |= t.kind[p[i]] ^ code_table::single_byte;
+                }
+                if (!bad)
+                {
+                    p = end;
+                    q += n;
+                    continue;
+                }
+            }
+
+            // one by one to the end of block, fast again if all single.
+            fast = true;
+            while (p < end)
+            {
+                auto const k = t.kind[*p];
+                if (k == code_table::single_byte)
+                {
+                    *q++ = static_cast<wchar_t>(t.single[*p++]);
+                    continue;
+                }
+
+                fast = false;
+                auto const cut = (k == code_table::lead_byte && last - p < 2);
+                if (k == code_table::lead_byte && !cut && t.pair[p[0] << 8 | p[1]])
+                {
+                    *q++ = static_cast<wchar_t>(t.pair[p[0] << 8 | p[1]]);
+                    p += 2;
+                    continue;
+                }
+
+                if (this->po_ == policy::strict)
+                    // same error as iconv
+                {
+                    throw std::system_error(
+                        std::make_error_code(
+                            cut ? std::errc::invalid_argument
+                                : std::errc::illegal_byte_sequence)
+                        , "table decode");
+                }
+                ++invalid;
+                if (this->po_ == policy::stop)
+                {
+                    p = last;
+                    break;
+                }
+                if (this->po_ == policy::replace)
+                {
+                    *q++ = static_cast<wchar_t>(0xFFFD);
+                }
+                ++p;
+            }
+        }
+        meter.finish(in_size);
+        out_size = static_cast<std::size_t>(q - out);
+
+        basic_newline_filter<wchar_t> filter(this->nl_);
+        if (filter)
+        {
+            out_size = static_cast<std::size_t>(
+                filter(out, out + out_size) - out);
+        }
+        return invalid;
+    }
+
+private:
+    table_store::table_ptr table_;
+};
+
+} // namespace detail
+
+namespace tables
+{
+
+// directory of table files, empty to keep tables in memory only.
+inline void set_directory(std::string const& dir)
+{
+    detail::table_store::instance().set_directory(dir);
+}
+
+inline std::string directory()
+{
+    return detail::table_store::instance().directory();
+}
+
+// whether cp is converted by lookup table, load or probe it if not yet.
+inline bool available(codepage::type cp)
+{
+    return detail::table_impl::supports(cp)
+        && detail::table_store::instance().find(cp) != nullptr;
+}
+
+// forget loaded tables, conversions in progress keep theirs.
+inline void clear()
+{
+    detail::table_store::instance().clear();
+}
+
+}  // namespace tables
+
+#endif  // YMH_UNA_WITH_TABLES && YMH_UNA_WITH_ICONV
+
+/*****************************************************************************/
+/* Create Codec Implement Instance. */
+
+//
+// Backends are looked up at runtime by codepage, the later registered one
+// takes precedence unless another is preferred for the codepage.
+//
+// Built-in backends are "native" (UTF-8, UCS-2) and the platform one,
+// "iconv" or "win" (all codepages), which is used by default.
+// "table" (single and double byte) precedes them if YMH_UNA_WITH_TABLES.
+//
+namespace backend
+{
+
+// base class of backends.
+typedef detail::codec_impl codec_impl;
+
+typedef std::function<bool (codepage::type)> predicate;
+
+typedef std::function<std::shared_ptr<codec_impl> (codepage::type
+                                                   , bom::type
+                                                   , policy::type
+                                                   , std::string const&
+                                                   , normalize::type)> factory;
+
+struct timing
+{
+    codepage::type cp;
+    std::string name;
+    std::uint64_t nanoseconds;  // best round trip of sample text
+};
+
+}  // namespace backend
+
+namespace detail
+{
+
+class backend_registry
+{
+public:
+    static CONSTEXPR int cp_slots = codepage::cp_latin1 + 1;
+
+    struct entry
+    {
+        std::string name;
+        backend::predicate supports;
+        backend::factory create;
+    };
+
+    struct table
+    {
+        std::vector<entry> entries;         // precedence order
+        std::string preferred[cp_slots];    // empty if none
+        entry const* resolved[cp_slots];
+    };
+
+    static backend_registry& instance()
+    {
+        static backend_registry registry;
+        return registry;
+    }
+
+    // lock free unless the table was changed since last call of thread.
+    std::shared_ptr<table const> snapshot()
+    {
+        static thread_local std::shared_ptr<table const> local;
+        static thread_local unsigned local_generation = 0;
+
+        auto const g = generation_.load(std::memory_order_acquire);
+        if (!local || local_generation != g)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            local = table_;
+            local_generation = generation_.load(std::memory_order_relaxed);
+        }
+        return local;
+    }
+
+    // changed by every update, e.g. backend::prefer() and calibrate().
+    unsigned generation() const
+    {
+        return generation_.load(std::memory_order_acquire);
+    }
+
+    template <class Modify>
+    void update(Modify modify)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto t = std::make_shared<table>(*table_);
+        modify(*t);
+        resolve(*t);
+        table_ = t;
+        generation_.fetch_add(1, std::memory_order_release);
+    }
+
+private:
+    backend_registry()
+        : table_(std::make_shared<table>())
+    {
+        generation_.store(1, std::memory_order_relaxed);
+
+        auto t = std::make_shared<table>();
+        t->entries.push_back(make_entry<native_impl>(
+            "native", &native_impl::supports));
+        t->preferred[codepage::cp_latin1] = "native";
+#if defined(_WIN32) || defined(_MSC_VER)
+        t->entries.insert(t->entries.begin(), make_entry<win_impl>("win"));
+#elif defined(YMH_UNA_WITH_ICONV)
+        t->entries.insert(t->entries.begin(), make_entry<iconv_impl>("iconv"));
+#endif // _WIN32 || _MSC_VER
+#if defined(YMH_UNA_WITH_TABLES) && defined(YMH_UNA_WITH_ICONV)
+        entry e;
+        e.name = "table";
+        e.supports = &table_impl::supports;
+        e.create = &table_impl::create;
+        t->entries.insert(t->entries.begin(), e);
+#endif  // YMH_UNA_WITH_TABLES && YMH_UNA_WITH_ICONV
+        resolve(*t);
+        table_ = t;
+    }
+
+    template <class Impl>
+    static entry make_entry(std::string const& name
+                            , backend::predicate const& supports
+                            = backend::predicate())
+    {
+        entry e;
+        e.name = name;
+        e.supports = supports ? supports : [](codepage::type) { return true; };
+        e.create = [](codepage::type cp, bom::type bo, policy::type po
+                      , std::string const& replacement, normalize::type nl)
+        {
+            return std::static_pointer_cast<codec_impl>(
+                std::make_shared<Impl>(cp, bo, po, replacement, nl));
+        };
+        return e;
+    }
+
+    static void resolve(table& t)
+    {
+        for (int cp = 0; cp != cp_slots; ++cp)
+        {
+            auto const c = static_cast<codepage::type>(cp);
+            t.resolved[cp] = nullptr;
+            for (auto const& e : t.entries)
+            {
+                if (!e.supports(c))
+                {
+                    continue;
+                }
+                if (e.name == t.preferred[cp])
+                {
+                    t.resolved[cp] = &e;
+                    break;
+                }
+                if (!t.resolved[cp])
+                {
+                    t.resolved[cp] = &e;
+                }
+            }
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::shared_ptr<table> table_;
+    std::atomic<unsigned> generation_;
+};
+
+inline std::shared_ptr<codec_impl>
+codec_impl::create_instance(codepage::type cp, bom::type bo
+                            , policy::type po, std::string const& replacement
+                            , normalize::type nl)
+{
+    auto const t = backend_registry::instance().snapshot();
+    auto const e = (0 <= cp && cp < backend_registry::cp_slots)
+        ? t->resolved[cp] : nullptr;
+    if (!e)
+    {
+        throw std::system_error(
+            std::make_error_code(std::errc::function_not_supported)
+            , std::string("No codec backend for ") + codepage_name(cp));
+    }
+    return e->create(cp, bo, po, replacement, nl);
+}
+
+} // namespace detail
+
+namespace backend
+{
+
+// register or replace backend name, it takes precedence of others.
+inline void add(std::string const& name, predicate const& supports
+                , factory const& create)
+{
+    detail::backend_registry::instance().update([&](
+        detail::backend_registry::table& t)
+    {
+        auto& entries = t.entries;
+        entries.erase(std::remove_if(entries.begin(), entries.end()
+                                     , [&](detail::backend_registry::entry
+                                           const& e)
+        {
+            return e.name == name;
+        }), entries.end());
+
+        detail::backend_registry::entry e;
+        e.name = name;
+        e.supports = supports;
+        e.create = create;
+        entries.insert(entries.begin(), e);
+    });
+}
+
+inline void remove(std::string const& name)
+{
+    detail::backend_registry::instance().update([&](
+        detail::backend_registry::table& t)
+    {
+        auto& entries = t.entries;
+        entries.erase(std::remove_if(entries.begin(), entries.end()
+                                     , [&](detail::backend_registry::entry
+                                           const& e)
+        {
+            return e.name == name;
+        }), entries.end());
+    });
+}
+
+// names in precedence order.
+inline std::vector<std::string> names()
+{
+    std::vector<std::string> v;
+    for (auto const& e : detail::backend_registry::instance()
+                             .snapshot()->entries)
+    {
+        v.push_back(e.name);
+    }
+    return v;
+}
+
+// name of backend which converts cp, empty if none.
+inline std::string current(codepage::type cp)
+{
+    auto const t = detail::backend_registry::instance().snapshot();
+    auto const e = (0 <= cp && cp < detail::backend_registry::cp_slots)
+        ? t->resolved[cp] : nullptr;
+    return e ? e->name : std::string();
+}
+
+// use backend name for cp if it supports, empty name to reset.
+inline void prefer(codepage::type cp, std::string const& name)
+{
+    if (cp < 0 || cp >= detail::backend_registry::cp_slots)
+    {
+        return ;
+    }
+    detail::backend_registry::instance().update([&](
+        detail::backend_registry::table& t)
+    {
+        t.preferred[cp] = name;
+    });
+}
+
+//
+// Time round trip of sample text by every backend for every codepage,
+// then prefer the fastest one. Call it once at startup if you like.
+//
+// Backends which fail sample text are skipped.
+//
+inline std::vector<timing> calibrate(std::size_t sample_size = 16 * 1024
+                                     , int rounds = 3)
+{
+    using namespace codepage;
+    static codepage::type const cps[] = { cp_default
+                                          , cp_utf8
+                                          , cp_gb2312
+                                          , cp_gb18030
+                                          , cp_ucs2_le
+                                          , cp_ucs2_be
+                                          , cp_latin1 };
+
+    std::vector<timing> timings;
+    auto const t = detail::backend_registry::instance().snapshot();
+    for (auto const cp : cps)
+    {
+        // ascii is encodable everywhere, and some Han (or e acute) if it can.
+        std::wstring sample(sample_size, L'a');
+        for (std::size_t i = 0; i < sample_size; ++i)
+        {
+            sample[i] = static_cast<wchar_t>(L'a' + i % 26);
+            if (cp != cp_default && i % 4 == 3)
+            {
+                sample[i] = static_cast<wchar_t>(
+                    (cp == cp_latin1) ? 0xE9 : 0x4E2D);
+            }
+        }
+
+        timing best;
+        best.cp = cp;
+        best.nanoseconds = 0;
+        for (auto const& e : t->entries)
+        {
+            if (!e.supports(cp))
+            {
+                continue;
+            }
+
+            std::uint64_t ns = 0;
+            try
+            {
+                auto const ci = e.create(cp, bom::nobomb, policy::strict
+                                         , std::string(), normalize::none);
+                std::string bytes;
+                std::wstring wtext;
+                for (int r = 0; r < rounds; ++r)
+                {
+                    auto const begin = std::chrono::steady_clock::now();
+                    std::size_t out_size = 0;
+                    ci->encode_impl(sample.data(), sample.size(), out_size
+                                    , [&](std::size_t n)
+                    {
+                        bytes.resize(n);
+                        return &bytes[0];
+                    });
+                    bytes.resize(out_size);
+                    ci->decode_impl(bytes.data(), bytes.size(), out_size
+                                    , [&](std::size_t n)
+                    {
+                        wtext.resize(n);
+                        return &wtext[0];
+                    });
+                    wtext.resize(out_size);
+                    auto const d = std::chrono::duration_cast<
+                        std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - begin).count();
+                    if (!r || static_cast<std::uint64_t>(d) < ns)
+                    {
+                        ns = static_cast<std::uint64_t>(d);
+                    }
+                }
+                if (wtext != sample)
+                {
+                    continue;
+                }
+            }
+            catch (std::exception const&)
+            {
+                continue;
+            }
+
+            timing ti;
+            ti.cp = cp;
+            ti.name = e.name;
+            ti.nanoseconds = ns;
+            timings.push_back(ti);
+            if (best.name.empty() || ns < best.nanoseconds)
+            {
+                best = ti;
+            }
+        }
+
+        if (!best.name.empty())
+        {
+            prefer(cp, best.name);
+        }
+    }
+    return timings;
+}
+
+}  // namespace backend
+
+/*****************************************************************************/
+/* Convenient User Interface. */
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG
+          , policy::type po POLICY_DEFAULT_TEMPLATE_ARG>
+inline std::string encode(std::wstring const& wstr)
+{
+    return codec(cp, bo, po)(wstr);
+}
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG
+          , policy::type po POLICY_DEFAULT_TEMPLATE_ARG>
+inline std::string encode(std::wstring const& wstr, std::size_t& invalid)
+{
+    return codec(cp, bo, po).encode(wstr, invalid);
+}
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG
+          , policy::type po POLICY_DEFAULT_TEMPLATE_ARG>
+inline codec::char_ptr encode(wchar_t const* wstr
+                            , std::size_t in_size, std::size_t& out_size)
+{
+    return std::move(codec(cp, bo, po)(wstr, in_size, out_size));
+}
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG
+          , policy::type po POLICY_DEFAULT_TEMPLATE_ARG>
+inline codec::char_ptr encode(wchar_t const* wstr
+                            , std::size_t in_size, std::size_t& out_size
+                            , std::size_t& invalid)
+{
+    return std::move(codec(cp, bo, po).encode(wstr, in_size, out_size
+                                              , invalid));
+}
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG
+          , policy::type po POLICY_DEFAULT_TEMPLATE_ARG
+          , normalize::type nl NORMALIZE_DEFAULT_TEMPLATE_ARG>
+inline std::wstring decode(std::string const& bytes)
+{
+    return codec(cp, bo, po, std::string(), nl)(bytes);
+}
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG
+          , policy::type po POLICY_DEFAULT_TEMPLATE_ARG
+          , normalize::type nl NORMALIZE_DEFAULT_TEMPLATE_ARG>
+inline std::wstring decode(std::string const& bytes, std::size_t& invalid)
+{
+    return codec(cp, bo, po, std::string(), nl).decode(bytes, invalid);
+}
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG
+          , policy::type po POLICY_DEFAULT_TEMPLATE_ARG
+          , normalize::type nl NORMALIZE_DEFAULT_TEMPLATE_ARG>
+inline codec::wchar_ptr decode(char const* bytes
+                             , std::size_t in_size, std::size_t& out_size)
+{
+    return std::move(codec(cp, bo, po, std::string(), nl)(bytes, in_size
+                                                          , out_size));
+}
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG
+          , policy::type po POLICY_DEFAULT_TEMPLATE_ARG
+          , normalize::type nl NORMALIZE_DEFAULT_TEMPLATE_ARG>
+inline codec::wchar_ptr decode(char const* bytes
+                             , std::size_t in_size, std::size_t& out_size
+                             , std::size_t& invalid)
+{
+    return std::move(codec(cp, bo, po, std::string(), nl).decode(
+                         bytes, in_size, out_size, invalid));
+}
+
+template <codepage::type from_cp CP_DEFAULT_TEMPLATE_ARG
+          , codepage::type to_cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type from_bo BOM_DEFAULT_TEMPLATE_ARG
+          , bom::type to_bo BOM_DEFAULT_TEMPLATE_ARG
+          , policy::type po POLICY_DEFAULT_TEMPLATE_ARG
+          , normalize::type nl NORMALIZE_DEFAULT_TEMPLATE_ARG
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+, typename std::enable_if<
+    from_cp != to_cp || from_bo != to_bo
+    || po != policy::strict || nl != normalize::none, int>::type = 0 >
+#else
+>
+#endif
+inline codec::char_ptr convert(char const* bytes
+                             , std::size_t in_size, std::size_t& out_size)
+{
+    detail::progress_call call;
+    auto p = decode<from_cp, from_bo, po, nl>(bytes, in_size, out_size);
+    return encode<to_cp, to_bo, po>(p.get(), out_size, out_size);
+}
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+template <codepage::type from_cp CP_DEFAULT_TEMPLATE_ARG
+          , codepage::type to_cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type from_bo BOM_DEFAULT_TEMPLATE_ARG
+          , bom::type to_bo BOM_DEFAULT_TEMPLATE_ARG
+          , policy::type po POLICY_DEFAULT_TEMPLATE_ARG
+          , normalize::type nl NORMALIZE_DEFAULT_TEMPLATE_ARG
+          , typename std::enable_if<
+                from_cp == to_cp && from_bo == to_bo
+                && po == policy::strict && nl == normalize::none
+                , int>::type = 0>
+inline codec::char_ptr convert(char const* bytes
+                             , std::size_t in_size, std::size_t& out_size)
+{
+    // TODO: have better ?
+    codec::char_ptr to(new char[in_size]);
+    std::copy(bytes, bytes + in_size, to.get());
+    out_size = in_size;
+    return std::move(to);
+}
+#else
+// need c++11
+#endif
+
+template <codepage::type from_cp CP_DEFAULT_TEMPLATE_ARG
+          , codepage::type to_cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type from_bo BOM_DEFAULT_TEMPLATE_ARG
+          , bom::type to_bo BOM_DEFAULT_TEMPLATE_ARG
+          , policy::type po POLICY_DEFAULT_TEMPLATE_ARG
+          , normalize::type nl NORMALIZE_DEFAULT_TEMPLATE_ARG
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+, typename std::enable_if<
+    from_cp != to_cp || from_bo != to_bo
+    || po != policy::strict || nl != normalize::none, int>::type = 0>
+#else
+>
+#endif
+inline std::string convert(std::string const& bytes)
+{
+    detail::progress_call call;
+    return encode<to_cp, to_bo, po>(decode<from_cp, from_bo, po, nl>(bytes));
+}
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+template <codepage::type from_cp CP_DEFAULT_TEMPLATE_ARG
+          , codepage::type to_cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type from_bo BOM_DEFAULT_TEMPLATE_ARG
+          , bom::type to_bo BOM_DEFAULT_TEMPLATE_ARG
+          , policy::type po POLICY_DEFAULT_TEMPLATE_ARG
+          , normalize::type nl NORMALIZE_DEFAULT_TEMPLATE_ARG
+          , typename std::enable_if<
+                from_cp == to_cp && from_bo == to_bo
+                && po == policy::strict && nl == normalize::none
+                , int>::type = 0>
+inline std::string convert(std::string const& bytes)
+{
+    return bytes;
+}
+#else
+// need c++11
+#endif
+
+// invalid: the number of invalid sequences handled by policy.
+template <codepage::type from_cp CP_DEFAULT_TEMPLATE_ARG
+          , codepage::type to_cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type from_bo BOM_DEFAULT_TEMPLATE_ARG
+          , bom::type to_bo BOM_DEFAULT_TEMPLATE_ARG
+          , policy::type po POLICY_DEFAULT_TEMPLATE_ARG
+          , normalize::type nl NORMALIZE_DEFAULT_TEMPLATE_ARG>
+inline std::string convert(std::string const& bytes, std::size_t& invalid)
+{
+    detail::progress_call call;
+    std::size_t en_invalid = 0;
+    auto const wtext = decode<from_cp, from_bo, po, nl>(bytes, invalid);
+    auto text = encode<to_cp, to_bo, po>(wtext, en_invalid);
+    invalid += en_invalid;
+    return text;
+}
+
+// UnicodeToANSI
+template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline std::string UnicodeToANSI(std::wstring const& wstr)
+{
+    return encode<codepage::cp_default, bo>(wstr);
+}
+
+template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline codec::char_ptr UnicodeToANSI(wchar_t const* wstr, std::size_t in_size
+                                     , std::size_t& out_size)
+{
+    return std::move(encode<codepage::cp_default, bo>(wstr, in_size
+                                                      , out_size));
+}
+
+// ANSIToUnicode
+template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline std::wstring ANSIToUnicode(std::string const& bytes)
+{
+    return decode<codepage::cp_default, bo>(bytes);
+}
+
+template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline codec::wchar_ptr ANSIToUnicode(char const* bytes, std::size_t in_size
+                                      , std::size_t& out_size)
+{
+    return std::move(decode<codepage::cp_default, bo>(bytes, in_size
+                                                      , out_size));
+}
+
+// UnicodeToUTF8
+template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline std::string UnicodeToUTF8(std::wstring const& wstr)
+{
+    return encode<codepage::cp_utf8, bo>(wstr);
+}
+
+template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline codec::char_ptr UnicodeToUTF8(wchar_t const* wstr, std::size_t in_size
+                                     , std::size_t& out_size)
+{
+    return std::move(encode<codepage::cp_utf8, bo>(wstr, in_size, out_size));
+}
+
+// UTF8ToUnicode
+template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline std::wstring UTF8ToUnicode(std::string const& bytes)
+{
+    return decode<codepage::cp_utf8, bo>(bytes);
+}
+
+template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline codec::wchar_ptr UTF8ToUnicode(char const* bytes, std::size_t in_size
+                                      , std::size_t& out_size)
+{
+    return std::move(decode<codepage::cp_utf8, bo>(bytes, in_size, out_size));
+}
+
+// UnicodeToGB2312
+template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline std::string UnicodeToGB2312(std::wstring const& wstr)
+{
+    return encode<codepage::cp_gb2312, bo>(wstr);
+}
+
+template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline codec::char_ptr UnicodeToGB2312(wchar_t const* wstr
+                                       , std::size_t in_size
+                                       , std::size_t& out_size)
+{
+    return std::move(encode<codepage::cp_gb2312, bo>(wstr, in_size, out_size));
+}
+
+// GB2312ToUnicode
+template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline std::wstring GB2312ToUnicode(std::string const& bytes)
+{
+    return decode<codepage::cp_gb2312, bo>(bytes);
+}
+
+template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline codec::wchar_ptr GB2312ToUnicode(char const* bytes
+                                        , std::size_t in_size
+                                        , std::size_t& out_size)
+{
+    return std::move(decode<codepage::cp_gb2312, bo>(bytes, in_size
+                                                     , out_size));
+}
+
+/*****************************************************************************/
+/* Compile-time Literal. */
+
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+
+#if defined(__cpp_consteval)
+#   define YMH_UNA_CONSTEVAL consteval
+#else
+#   define YMH_UNA_CONSTEVAL constexpr
+#endif  // __cpp_consteval
+
+//
+// Transcode UTF-8 literals at compile time, result lives in .rodata
+// if it's a constexpr variable. Invalid UTF-8 fails compiling.
+//
+//     static constexpr auto title = literal<wchar_t>(u8"中文");
+//     ::MessageBoxW(nullptr, title.c_str(), nullptr, MB_OK);
+//
+// @note GB2312/GB18030 need the whole mapping table, use encode<cp>.
+//
+template <class CharT, std::size_t N>
+class basic_literal
+{
+public:
+    typedef CharT value_type;
+
+    constexpr CharT const* data() const
+    {
+        return data_;
+    }
+
+    constexpr CharT const* c_str() const
+    {
+        return data_;
+    }
+
+    constexpr std::size_t size() const
+    {
+        return size_;
+    }
+
+    constexpr CharT const* begin() const
+    {
+        return data_;
+    }
+
+    constexpr CharT const* end() const
+    {
+        return data_ + size_;
+    }
+
+    constexpr CharT operator[](std::size_t i) const
+    {
+        return data_[i];
+    }
+
+    std::basic_string<CharT> str() const
+    {
+        return std::basic_string<CharT>(data_, size_);
+    }
+
+    constexpr void push_back(CharT c)
+    {
+        data_[size_++] = c;
+    }
+
+private:
+    CharT data_[N] = {};  // null terminated
+    std::size_t size_ = 0;
+};
+
+namespace detail
+{
+
+// decode one character at i, advance i.
+template <class T>
+constexpr char32_t literal_next(T const* s, std::size_t n, std::size_t& i)
+{
+    auto const lead = static_cast<unsigned char>(s[i++]);
+    if (lead < 0x80)
+    {
+        return lead;
+    }
+
+    std::size_t m = 0;
+    char32_t c = 0;
+    char32_t min = 0;
+    if (0xC2 <= lead && lead < 0xE0)
+    {
+        m = 1; c = lead & 0x1F; min = 0x80;
+    }
+    else if (0xE0 <= lead && lead < 0xF0)
+    {
+        m = 2; c = lead & 0x0F; min = 0x800;
+    }
+    else if (0xF0 <= lead && lead < 0xF5)
+    {
+        m = 3; c = lead & 0x07; min = 0x10000;
+    }
+    else
+    {
+        throw std::invalid_argument("Invalid UTF-8 literal");
+    }
+
+    for ( ; m; --m)
+    {
+        if (i == n || (static_cast<unsigned char>(s[i]) & 0xC0) != 0x80)
+        {
+            throw std::invalid_argument("Invalid UTF-8 literal");
+        }
+        c = (c << 6) | (static_cast<unsigned char>(s[i++]) & 0x3F);
+    }
+    if (c < min || c > 0x10FFFF || (0xD800 <= c && c <= 0xDFFF))
+    {
+        throw std::invalid_argument("Invalid UTF-8 literal");
+    }
+    return c;
+}
+
+// N - 1 units at most, surrogate pair comes from 4 bytes.
+template <class CharT, class T, std::size_t N>
+constexpr basic_literal<CharT, N> literal_units(T const (&u8)[N])
+{
+    basic_literal<CharT, N> r;
+    for (std::size_t i = 0; i < N - 1; )
+    {
+        auto const c = literal_next(u8, N - 1, i);
+        if (sizeof(CharT) == 2 && c > 0xFFFF)
+        {
+            r.push_back(static_cast<CharT>(0xD800 + ((c - 0x10000) >> 10)));
+            r.push_back(static_cast<CharT>(0xDC00 + ((c - 0x10000) & 0x3FF)));
+        }
+        else
+        {
+            r.push_back(static_cast<CharT>(c));
+        }
+    }
+    return r;
+}
+
+template <codepage::type cp, class T, std::size_t N>
+constexpr basic_literal<char, 2 * N> literal_bytes(T const (&u8)[N])
+{
+    static_assert(cp == codepage::cp_utf8 || cp == codepage::cp_ucs2_le
+                  || cp == codepage::cp_ucs2_be
+                  , "compile-time literal supports UTF-8 and UCS-2 only");
+
+    basic_literal<char, 2 * N> r;
+    for (std::size_t i = 0; i < N - 1; )
+    {
+        auto b = i;
+        auto const c = literal_next(u8, N - 1, i);
+        if (cp == codepage::cp_utf8)
+            // validated, copy as is.
+        {
+            for ( ; b != i; ++b)
+            {
+                r.push_back(static_cast<char>(u8[b]));
+            }
+            continue;
+        }
+        if (c > 0xFFFF)
+        {
+            throw std::invalid_argument("Out of UCS-2 literal");
+        }
+        auto const hi = static_cast<char>(c >> 8);
+        auto const lo = static_cast<char>(c & 0xFF);
+        r.push_back(cp == codepage::cp_ucs2_le ? lo : hi);
+        r.push_back(cp == codepage::cp_ucs2_le ? hi : lo);
+    }
+    return r;
+}
+
+}  // namespace detail
+
+// wchar_t, char16_t (UTF-16) or char32_t (UTF-32) units.
+template <class CharT, std::size_t N>
+YMH_UNA_CONSTEVAL basic_literal<CharT, N> literal(char const (&u8)[N])
+{
+    return detail::literal_units<CharT>(u8);
+}
+
+// encoded bytes of codepage cp.
+template <codepage::type cp, std::size_t N>
+YMH_UNA_CONSTEVAL basic_literal<char, 2 * N> literal(char const (&u8)[N])
+{
+    return detail::literal_bytes<cp>(u8);
+}
+
+#if defined(__cpp_char8_t)
+template <class CharT, std::size_t N>
+YMH_UNA_CONSTEVAL basic_literal<CharT, N> literal(char8_t const (&u8)[N])
+{
+    return detail::literal_units<CharT>(u8);
+}
+
+template <codepage::type cp, std::size_t N>
+YMH_UNA_CONSTEVAL basic_literal<char, 2 * N> literal(char8_t const (&u8)[N])
+{
+    return detail::literal_bytes<cp>(u8);
+}
+#endif  // __cpp_char8_t
+
+#endif  // __cplusplus >= 201402L
+
+/*****************************************************************************/
+/* Codepoint View. */
+
+namespace detail
+{
+
+// decode one character of codepages without native decoder, it keeps
+// iconv descriptor (or codecvt facet) while iterating.
+class char_decoder
+{
+public:
+    explicit char_decoder(codepage::type cp)
+        : cp_(cp)
+    {
+        if (cp == codepage::cp_default)
+        {
+            loc_ = std::locale("");
+            return ;
+        }
+#if defined(YMH_UNA_WITH_ICONV) && !defined(_WIN32)
+        auto cd = ::iconv_open(default_wide_charset().c_str()
+                               , to_iconv_codepage(cp).c_str());
+        if (cd == (iconv_t)(-1))
+        {
+            throw std::system_error(
+                std::error_code(errno, std::system_category())
+                , "iconv_open for decode");
+        }
+        stats_add(cp, stats::wide, stats::iconv_opens);
+        cd_.reset(cd, [](iconv_t cd) { ::iconv_close(cd); });
+#endif  // YMH_UNA_WITH_ICONV && !_WIN32
+    }
+
+    std::size_t operator()(char const* first, char const* last
+                           , char32_t& c) const
+    {
+        wchar_t out[2] = { 0 };
+        std::size_t out_size = 0;
+        std::size_t n = 0;
+        if (cp_ == codepage::cp_default)
+        {
+            n = by_codecvt(first, last, out, out_size);
+        }
+        else
+        {
+            n = by_platform(first, last, out, out_size);
+        }
+
+        if (!out_size)
+        {
+            c = g_bad_codepoint;
+            return 1;
+        }
+        c = static_cast<char32_t>(out[0]);
+        if (out_size == 2)
+            // surrogate pair if wchar_t is 16 bits.
+        {
+            c = 0x10000 + ((c - 0xD800) << 10)
+                + (static_cast<char32_t>(out[1]) - 0xDC00);
+        }
+        return n;
+    }
+
+private:
+    std::size_t by_codecvt(char const* first, char const* last
+                           , wchar_t* out, std::size_t& out_size) const
+    {
+        typedef std::codecvt<wchar_t, char, std::mbstate_t> cvt_facet;
+        auto& cvt = std::use_facet<cvt_facet>(loc_);
+
+        // room for one character, surrogate pair needs two units.
+        auto const end = (cvt.max_length() > 0
+                          && last - first > cvt.max_length())
+            ? first + cvt.max_length() : last;
+        for (std::size_t m = 1; m <= 2 && !out_size; ++m)
+        {
+            std::mbstate_t state = std::mbstate_t();
+            char const* fn = nullptr;
+            wchar_t* tn = nullptr;
+            auto const result = cvt.in(state, first, end, fn
+                                       , out, out + m, tn);
+            if (result == cvt_facet::error && tn == out)
+            {
+                break;
+            }
+            out_size = static_cast<std::size_t>(tn - out);
+            if (out_size)
+            {
+                return static_cast<std::size_t>(fn - first);
+            }
+        }
+        return 1;
+    }
+
+#if defined(_WIN32) || defined(_MSC_VER)
+    std::size_t by_platform(char const* first, char const* last
+                            , wchar_t* out, std::size_t& out_size) const
+    {
+        auto const lead = static_cast<unsigned char>(first[0]);
+        auto n = std::size_t(1);
+        if (0x81 <= lead && lead <= 0xFE && last - first >= 2)
+        {
+            auto const trail = static_cast<unsigned char>(first[1]);
+            n = (cp_ == codepage::cp_gb18030 && 0x30 <= trail && trail <= 0x39)
+                ? 4 : 2;
+        }
+        if (static_cast<std::size_t>(last - first) < n)
+        {
+            return 1;
+        }
+
+        auto const m = detail::MultiByteToWideChar(
+            cp_, first, static_cast<int>(n), out, 2);
+        out_size = (m > 0 && out[0] != g_bad_codepoint)
+            ? static_cast<std::size_t>(m) : 0;
+        return n;
+    }
+#elif defined(YMH_UNA_WITH_ICONV)
+    std::size_t by_platform(char const* first, char const* last
+                            , wchar_t* out, std::size_t& out_size) const
+    {
+        // output has room for one character, so iconv stops after it.
+        // iconv costs as much as input it's given, give one character.
+        CONSTEXPR size_t gb_max_bytes = 4;
+        char* inbuf = const_cast<char*>(first);
+        size_t inbytesleft = (std::min)(static_cast<size_t>(last - first)
+                                        , gb_max_bytes);
+        char* outbuf = reinterpret_cast<char*>(out);
+        size_t outbytesleft = sizeof(wchar_t);
+
+        auto const cd = static_cast<iconv_t>(cd_.get());
+        ::iconv(cd, nullptr, nullptr, nullptr, nullptr);
+        ::iconv(cd, &inbuf, &inbytesleft, &outbuf, &outbytesleft);
+        if (outbytesleft)
+        {
+            return 1;
+        }
+        out_size = 1;
+        return static_cast<std::size_t>(inbuf - first);
+    }
+#endif // _WIN32 || _MSC_VER
+
+private:
+    codepage::type cp_;
+    std::locale loc_;
+    std::shared_ptr<void> cd_;
+};
+
+inline std::uint64_t load64(char const* p)
+{
+    std::uint64_t w;
+    std::memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+CONSTEXPR std::uint64_t g_high_bits = 0x8080808080808080ULL;
+
+// end of the ascii run at p, 8 bytes at a time.
+inline char const* skip_ascii(char const* p, char const* last)
+{
+    while (last - p >= 8 && !(load64(p) & g_high_bits))
+    {
+        p += 8;
+    }
+    while (p != last && !(static_cast<unsigned char>(*p) & 0x80))
+    {
+        ++p;
+    }
+    return p;
+}
+
+} // namespace detail
+
+//
+// Iterate characters of encoded bytes without decoding them all, bytes
+// must outlive the view.
+//
+// Invalid sequences are yielded as one U+FFFD per byte (per unit for
+// UCS-2). ASCII runs of ASCII compatible codepages skip decoding, and
+// iterator::skip_ascii() jumps over them when only the rest matters.
+//
+//     std::size_t han = 0;
+//     for (char32_t c : codepoints<codepage::cp_gb18030>(bytes))
+//     {
+//         han += (0x4E00 <= c && c <= 0x9FFF);
+//     }
+//
+template <codepage::type cp, bom::type bo = bom::nobomb>
+class basic_codepoint_view
+{
+public:
+    class iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef char32_t value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef char32_t const* pointer;
+        typedef char32_t const& reference;
+
+        iterator()
+            : view_(nullptr), pos_(nullptr), ascii_(nullptr), len_(0), c_(0)
+        {}
+
+        iterator(basic_codepoint_view const* view, char const* pos)
+            : view_(view), pos_(pos), ascii_(pos), len_(0), c_(0)
+        {
+            fetch();
+        }
+
+        reference operator*() const
+        {
+            return c_;
+        }
+
+        pointer operator->() const
+        {
+            return &c_;
+        }
+
+        iterator& operator++()
+        {
+            pos_ += len_;
+            fetch();
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(iterator const& rhs) const
+        {
+            return pos_ == rhs.pos_;
+        }
+
+        bool operator!=(iterator const& rhs) const
+        {
+            return pos_ != rhs.pos_;
+        }
+
+        // bytes of current character.
+        char const* base() const
+        {
+            return pos_;
+        }
+
+        std::size_t size() const
+        {
+            return len_;
+        }
+
+        // fast forward to the next non-ascii character or end, 8 bytes at
+        // a time. UCS-2 has no ascii bytes, it stays.
+        iterator& skip_ascii()
+        {
+            if (cp != codepage::cp_ucs2_le && cp != codepage::cp_ucs2_be)
+            {
+                pos_ = detail::skip_ascii(pos_, view_->last_);
+                ascii_ = pos_;
+                fetch();
+            }
+            return *this;
+        }
+
+    private:
+        void fetch()
+        {
+            if (pos_ < ascii_)
+                // in the ascii run found by next(), it ends by last_.
+            {
+                c_ = static_cast<unsigned char>(*pos_);
+                len_ = 1;
+            }
+            else if (pos_ != view_->last_)
+            {
+                len_ = view_->next(pos_, c_, ascii_);
+            }
+        }
+
+    private:
+        basic_codepoint_view const* view_;
+        char const* pos_;
+        char const* ascii_;  // end of ascii run found by next()
+        std::size_t len_;
+        char32_t c_;
+    };
+
+    typedef iterator const_iterator;
+
+    basic_codepoint_view(char const* bytes, std::size_t in_size)
+        : first_(bytes), last_(bytes + in_size)
+        , decoder_(is_native() ? nullptr
+                   : std::make_shared<detail::char_decoder>(cp))
+    {
+        auto const bom = detail::get_bom(cp);
+        if (bo == bom::bomb && bom.second && in_size >= bom.first
+            && std::equal(bom.second, bom.second + bom.first
+                          , reinterpret_cast<unsigned char const*>(bytes)))
+        {
+            first_ += bom.first;
+        }
+    }
+
+    iterator begin() const
+    {
+        return iterator(this, first_);
+    }
+
+    iterator end() const
+    {
+        return iterator(this, last_);
+    }
+
+    bool empty() const
+    {
+        return first_ == last_;
+    }
+
+    // bytes after BOM.
+    char const* data() const
+    {
+        return first_;
+    }
+
+    std::size_t size_bytes() const
+    {
+        return static_cast<std::size_t>(last_ - first_);
+    }
+
+private:
+    static CONSTEXPR bool is_native()
+    {
+        return cp == codepage::cp_utf8 || cp == codepage::cp_latin1
+            || cp == codepage::cp_ucs2_le || cp == codepage::cp_ucs2_be;
+    }
+
+    // ascii: end of ascii run at pos, or pos.
+    std::size_t next(char const* pos, char32_t& c, char const*& ascii) const
+    {
+        ascii = pos;
+        auto const p = reinterpret_cast<unsigned char const*>(pos);
+        if (cp == codepage::cp_ucs2_le || cp == codepage::cp_ucs2_be)
+        {
+            if (last_ - pos < 2)
+            {
+                c = detail::g_bad_codepoint;
+                return 1;
+            }
+            c = (cp == codepage::cp_ucs2_le) ? (p[1] << 8 | p[0])
+                                             : (p[0] << 8 | p[1]);
+            return 2;
+        }
+
+        if (cp == codepage::cp_latin1)
+        {
+            c = *p;
+            return 1;
+        }
+        if (*p < 0x80)
+            // ascii, skip the run word at a time.
+        {
+            ascii = detail::skip_ascii(pos, last_);
+            c = *p;
+            return 1;
+        }
+        if (cp == codepage::cp_utf8)
+        {
+            return detail::next_utf8(
+                p, reinterpret_cast<unsigned char const*>(last_), c);
+        }
+        return (*decoder_)(pos, last_, c);
+    }
+
+private:
+    char const* first_;
+    char const* last_;
+    std::shared_ptr<detail::char_decoder> decoder_;
+};
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline basic_codepoint_view<cp, bo> codepoints(char const* bytes
+                                               , std::size_t in_size)
+{
+    return basic_codepoint_view<cp, bo>(bytes, in_size);
+}
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline basic_codepoint_view<cp, bo> codepoints(std::string const& bytes)
+{
+    return basic_codepoint_view<cp, bo>(bytes.data(), bytes.size());
+}
+
+// view of temporary would dangle.
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+void codepoints(std::string&& bytes) = delete;
+
+/*****************************************************************************/
+/* Codepoint Index. */
+
+namespace detail
+{
+
+inline unsigned popcount64(std::uint64_t w)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_popcountll(w));
+#else
+    unsigned n = 0;
+    for ( ; w; w &= w - 1)
+    {
+        ++n;
+    }
+    return n;
+#endif  // __GNUC__ || __clang__
+}
+
+// characters which begin in the 8 bytes of w.
+template <codepage::type cp>
+inline unsigned count_chars64(std::uint64_t w)
+{
+    if (cp == codepage::cp_utf8)
+        // skip continuation bytes 10xxxxxx.
+    {
+        return 8 - popcount64(w & ~(w << 1) & g_high_bits);
+    }
+    return (w & g_high_bits) ? 0 : 8;  // ascii only, or unknown
+}
+
+// bytes of the character at p.
+template <codepage::type cp>
+inline std::size_t char_size(char const* p, char const* last)
+{
+    auto const c = static_cast<unsigned char>(*p);
+    if (cp == codepage::cp_utf8)
+    {
+        auto q = p + 1;
+        while (q != last && (static_cast<unsigned char>(*q) & 0xC0) == 0x80)
+        {
+            ++q;
+        }
+        return static_cast<std::size_t>(q - p);
+    }
+
+    // GB2312/GB18030: 1, 2 or 4 bytes.
+    if (c < 0x81 || c > 0xFE || last - p < 2)
+    {
+        return 1;
+    }
+    auto const c2 = static_cast<unsigned char>(p[1]);
+    if (cp == codepage::cp_gb18030 && 0x30 <= c2 && c2 <= 0x39)
+    {
+        return (last - p < 4) ? static_cast<std::size_t>(last - p) : 4;
+    }
+    return 2;
+}
+
+}  // namespace detail
+
+//
+// Sparse index of UTF-8, GB2312 or GB18030 bytes, it keeps byte offset of
+// every step-th character, so the bytes of characters [first, last) are
+// found in O(step) instead of O(size).
+//
+// Characters are counted as codepoints() does for valid input, BOM is
+// counted if any. Index is built in one pass, 8 bytes at a time for UTF-8
+// and for ASCII runs of GB.
+//
+//     auto idx = codepoint_index<codepage::cp_utf8>(text);
+//     idx.save("demo.txt.idx");
+//     auto wtext = decode_range(text, idx, 1000000, 80);
+//
+template <codepage::type cp>
+class basic_codepoint_index
+{
+    static_assert(cp == codepage::cp_utf8 || cp == codepage::cp_gb2312
+                  || cp == codepage::cp_gb18030
+                  , "codepoint index supports UTF-8, GB2312 and GB18030");
+
+public:
+    explicit basic_codepoint_index(std::size_t step = 4096)
+        : step_(step ? step : 1), bytes_(0), size_(0)
+    {}
+
+    basic_codepoint_index(char const* bytes, std::size_t in_size
+                          , std::size_t step = 4096)
+        : basic_codepoint_index(step)
+    {
+        build(bytes, in_size);
+    }
+
+    void build(char const* bytes, std::size_t in_size)
+    {
+        offsets_.clear();
+        offsets_.reserve(in_size / step_ + 1);
+        bytes_ = in_size;
+
+        auto p = bytes;
+        auto const last = bytes + in_size;
+        std::size_t n = 0;     // characters before p
+        std::size_t next = 0;  // next character to mark
+        while (p != last)
+        {
+            if (last - p >= 8)
+                // skip words which have no character to mark.
+            {
+                auto const k = detail::count_chars64<cp>(detail::load64(p));
+                if ((cp == codepage::cp_utf8 || k == 8) && n + k <= next)
+                {
+                    n += k;
+                    p += 8;
+                    continue;
+                }
+            }
+
+            if (cp == codepage::cp_utf8
+                && (static_cast<unsigned char>(*p) & 0xC0) == 0x80)
+                // continuation byte
+            {
+                ++p;
+                continue;
+            }
+
+            if (n == next)
+            {
+                offsets_.push_back(static_cast<std::size_t>(p - bytes));
+                next += step_;
+            }
+            p += (cp == codepage::cp_utf8) ? 1
+                : detail::char_size<cp>(p, last);
+            ++n;
+        }
+        size_ = n;
+    }
+
+    // number of characters.
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    std::size_t size_bytes() const
+    {
+        return bytes_;
+    }
+
+    std::size_t step() const
+    {
+        return step_;
+    }
+
+    // byte offset of the n-th character of bytes which built the index,
+    // size_bytes() if n >= size().
+    std::size_t offset(char const* bytes, std::size_t n) const
+    {
+        if (n >= size_)
+        {
+            return bytes_;
+        }
+
+        auto p = bytes + offsets_[n / step_];
+        auto const last = bytes + bytes_;
+        for (auto i = n % step_; i != 0 && p != last; --i)
+        {
+            p += detail::char_size<cp>(p, last);
+        }
+        return static_cast<std::size_t>(p - bytes);
+    }
+
+    // <offset, length> of characters [first, first + count).
+    std::pair<std::size_t, std::size_t>
+    range(char const* bytes, std::size_t first, std::size_t count) const
+    {
+        auto const b = offset(bytes, first);
+        auto const e = (count > size_ - (std::min)(first, size_))
+            ? bytes_ : offset(bytes, first + count);
+        return std::make_pair(b, e - b);
+    }
+
+    void save(std::ostream& ostrm) const
+    {
+        write(ostrm, magic());
+        write(ostrm, static_cast<std::uint64_t>(cp));
+        write(ostrm, static_cast<std::uint64_t>(step_));
+        write(ostrm, static_cast<std::uint64_t>(bytes_));
+        write(ostrm, static_cast<std::uint64_t>(size_));
+        write(ostrm, static_cast<std::uint64_t>(offsets_.size()));
+        for (auto const off : offsets_)
+        {
+            write(ostrm, static_cast<std::uint64_t>(off));
+        }
+        if (!ostrm)
+        {
+            throw std::system_error(std::make_error_code(std::errc::io_error)
+                                    , "Failed save codepoint index");
+        }
+    }
+
+    // throw if it isn't an index of cp, or bytes size differs.
+    void load(std::istream& istrm, std::size_t in_size)
+    {
+        std::uint64_t v[6] = { 0 };
+        for (auto& e : v)
+        {
+            e = read(istrm);
+        }
+
+        // a character has one byte at least.
+        auto const count = static_cast<std::size_t>(v[5]);
+        if (!istrm || v[0] != magic() || v[1] != cp || !v[2]
+            || v[3] != in_size || v[4] > in_size
+            || count != (v[4] ? (v[4] - 1) / v[2] + 1 : 0))
+        {
+            throw std::system_error(
+                std::make_error_code(std::errc::invalid_argument)
+                , "Stale or corrupt codepoint index");
+        }
+
+        std::vector<std::size_t> offsets(count);
+        for (auto& off : offsets)
+        {
+            off = static_cast<std::size_t>(read(istrm));
+        }
+        if (!istrm)
+        {
+            throw std::system_error(std::make_error_code(std::errc::io_error)
+                                    , "Truncated codepoint index");
+        }
+
+        // offset() walks from them, they must be inside bytes.
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            if (offsets[i] >= in_size || (i ? offsets[i] <= offsets[i - 1]
+                                          : offsets[i] != 0))
+            {
+                throw std::system_error(
+                    std::make_error_code(std::errc::invalid_argument)
+                    , "Corrupt codepoint index");
+            }
+        }
+
+        step_ = static_cast<std::size_t>(v[2]);
+        bytes_ = in_size;
+        size_ = static_cast<std::size_t>(v[4]);
+        offsets_.swap(offsets);
+    }
+
+    void save(std::string const& filename) const
+    {
+        std::ofstream ofile(filename.c_str()
+                            , std::ios_base::out | std::ios_base::binary);
+        if (!ofile)
+        {
+            throw std::system_error(
+                std::make_error_code(std::errc::no_such_file_or_directory)
+                , filename);
+        }
+        save(ofile);
+    }
+
+    void load(std::string const& filename, std::size_t in_size)
+    {
+        std::ifstream ifile(filename.c_str()
+                            , std::ios_base::in | std::ios_base::binary);
+        if (!ifile)
+        {
+            throw std::system_error(
+                std::make_error_code(std::errc::no_such_file_or_directory)
+                , filename);
+        }
+        load(ifile, in_size);
+    }
+
+private:
+    static CONSTEXPR std::uint64_t magic()
+    {
+        return 0x31584449414E55ULL;  // "UNAIDX1" little endian
+    }
+
+    // little endian whatever the platform is.
+    static void write(std::ostream& ostrm, std::uint64_t v)
+    {
+        char buf[8];
+        for (auto& c : buf)
+        {
+            c = static_cast<char>(v & 0xFF);
+            v >>= 8;
+        }
+        ostrm.write(buf, sizeof(buf));
+    }
+
+    static std::uint64_t read(std::istream& istrm)
+    {
+        unsigned char buf[8] = { 0 };
+        istrm.read(reinterpret_cast<char*>(buf), sizeof(buf));
+        std::uint64_t v = 0;
+        for (auto i = sizeof(buf); i != 0; --i)
+        {
+            v = (v << 8) | buf[i - 1];
+        }
+        return v;
+    }
+
+private:
+    std::size_t step_;
+    std::size_t bytes_;
+    std::size_t size_;
+    std::vector<std::size_t> offsets_;
+};
+
+template <codepage::type cp>
+inline basic_codepoint_index<cp> codepoint_index(std::string const& bytes
+                                                 , std::size_t step = 4096)
+{
+    return basic_codepoint_index<cp>(bytes.data(), bytes.size(), step);
+}
+
+// decode characters [first, first + count) only.
+template <codepage::type cp
+          , policy::type po POLICY_DEFAULT_TEMPLATE_ARG
+          , normalize::type nl NORMALIZE_DEFAULT_TEMPLATE_ARG>
+inline std::wstring decode_range(std::string const& bytes
+                                 , basic_codepoint_index<cp> const& index
+                                 , std::size_t first, std::size_t count)
+{
+    auto const r = index.range(bytes.data(), first, count);
+    if (!r.second)
+    {
+        return std::wstring();
+    }
+
+    std::size_t out_size = 0;
+    auto const p = decode<cp, bom::nobomb, po, nl>(bytes.data() + r.first
+                                                   , r.second, out_size);
+    return std::wstring(p.get(), out_size);
+}
+
+/*****************************************************************************/
+/* Encoded Text Search. */
+
+namespace detail
+{
+
+inline unsigned ctz32(std::uint32_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(v));
+#else
+    unsigned n = 0;
+    for ( ; !(v & 1); v >>= 1)
+    {
+        ++n;
+    }
+    return n;
+#endif  // __GNUC__ || __clang__
+}
+
+// first position of needle in [first, last), nullptr if not found.
+inline char const* find_bytes(char const* first, char const* last
+                              , char const* needle, std::size_t m)
+{
+    if (static_cast<std::size_t>(last - first) < m)
+    {
+        return nullptr;
+    }
+    if (!m)
+    {
+        return first;
+    }
+
+    auto const end = last - m + 1;  // candidates in [first, end)
+    auto p = first;
+#if defined(YMH_UNA_WITH_SSE2)
+    // compare first and last bytes of 16 candidates at once.
+    auto const vf = _mm_set1_epi8(needle[0]);
+    auto const vl = _mm_set1_epi8(needle[m - 1]);
+    for ( ; end - p >= 16; p += 16)
+    {
+        auto const bf = _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(p));
+        auto const bl = _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(p + m - 1));
+        auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(bf, vf), _mm_cmpeq_epi8(bl, vl))));
+        for ( ; mask; mask &= mask - 1)
+        {
+            auto const q = p + ctz32(mask);
+            if (std::memcmp(q, needle, m) == 0)
+            {
+                return q;
+            }
+        }
+    }
+#endif  // YMH_UNA_WITH_SSE2
+
+    while (p != end)
+    {
+        p = static_cast<char const*>(
+            std::memchr(p, needle[0], static_cast<std::size_t>(end - p)));
+        if (!p)
+        {
+            return nullptr;
+        }
+        if (p[m - 1] == needle[m - 1] && std::memcmp(p, needle, m) == 0)
+        {
+            return p;
+        }
+        ++p;
+    }
+    return nullptr;
+}
+
+// GBK/GB18030 trail bytes are in [0x30, 0x39], [0x40, 0x7E] or
+// [0x80, 0xFE], others are single byte characters.
+inline bool is_gb_anchor(unsigned char c)
+{
+    return c <= 0x2F || (0x3A <= c && c <= 0x3F);
+}
+
+}  // namespace detail
+
+//
+// Search text in encoded bytes without decoding them, needle is encoded
+// once by constructor.
+//
+// Matches are always at character boundary: UTF-8 is self synchronizing,
+// UCS-2 matches at even offset, and GB2312/GB18030 candidates are
+// verified by walking forward from the nearest single byte character.
+//
+//     basic_searcher<codepage::cp_gb18030> const s(L"关键字");
+//     for (auto pos = s.find(bytes); pos != s.npos
+//          ; pos = s.find(bytes, pos + s.size()))
+//     {
+//     }
+//
+template <codepage::type cp>
+class basic_searcher
+{
+    static_assert(cp != codepage::cp_default
+                  , "codepage of bytes must be known to search in it");
+
+public:
+    static CONSTEXPR std::size_t npos = std::string::npos;
+
+    explicit basic_searcher(std::wstring const& needle)
+        : needle_(encode<cp>(needle))
+    {}
+
+    // encoded needle
+    std::string const& needle() const
+    {
+        return needle_;
+    }
+
+    std::size_t size() const
+    {
+        return needle_.size();
+    }
+
+    // byte offset of first match at or after pos, pos must be at
+    // character boundary. npos if not found.
+    std::size_t find(char const* bytes, std::size_t in_size
+                     , std::size_t pos = 0) const
+    {
+        if (pos > in_size)
+        {
+            return npos;
+        }
+
+        auto const last = bytes + in_size;
+        auto boundary = bytes + pos;  // the last known character boundary
+        for (auto p = boundary; p <= last; ++p)
+        {
+            p = detail::find_bytes(p, last, needle_.data(), needle_.size());
+            if (!p)
+            {
+                break;
+            }
+            if (synchronized(p, last, boundary))
+            {
+                return static_cast<std::size_t>(p - bytes);
+            }
+        }
+        return npos;
+    }
+
+    std::size_t find(std::string const& bytes, std::size_t pos = 0) const
+    {
+        return find(bytes.data(), bytes.size(), pos);
+    }
+
+private:
+    bool synchronized(char const* p, char const* last
+                      , char const*& boundary) const
+    {
+        using namespace codepage;
+        if (cp == cp_utf8 || cp == cp_latin1)
+        {
+            return true;
+        }
+        if (cp == cp_ucs2_le || cp == cp_ucs2_be)
+        {
+            return (p - boundary) % 2 == 0;
+        }
+
+        if (p < boundary)
+            // inside the character which ends at boundary.
+        {
+            return false;
+        }
+
+        auto q = p;
+        while (q != boundary
+               && !detail::is_gb_anchor(static_cast<unsigned char>(q[-1])))
+        {
+            --q;
+        }
+        while (q < p)
+        {
+            q += detail::char_size<cp>(q, last);
+        }
+        boundary = q;
+        return q == p;
+    }
+
+private:
+    std::string needle_;
+};
+
+template <codepage::type cp>
+CONSTEXPR std::size_t basic_searcher<cp>::npos;
+
+// byte offset of first needle in bytes at or after pos, npos if not found.
+template <codepage::type cp>
+inline std::size_t search(std::string const& bytes
+                          , std::wstring const& needle, std::size_t pos = 0)
+{
+    return basic_searcher<cp>(needle).find(bytes, pos);
+}
+
+/*****************************************************************************/
+/* Streaming Validation. */
+
+//
+// UTF-8 validator of bytes which come piece by piece, e.g. a growing
+// receive buffer. Only new bytes are scanned, an incomplete sequence at
+// the end of a piece is carried to the next one.
+//
+// Sequences are checked strictly as RFC 3629: no overlong forms,
+// surrogates or codepoints above U+10FFFF, while utf8::is_utf8 is relaxed.
+//
+//     utf8_validator v;
+//     while (auto n = recv(fd, buf, sizeof(buf), 0))
+//     {
+//         data.append(buf, n);
+//         if (!v.feed(buf, n))
+//         {
+//             // bad at v.error_offset()
+//         }
+//     }
+//     bool ok = v.finish();  // and no truncated tail
+//
+class utf8_validator
+{
+public:
+    static CONSTEXPR std::size_t npos = static_cast<std::size_t>(-1);
+
+    utf8_validator()
+    {
+        reset();
+    }
+
+    // false if an invalid sequence is found so far, then bytes are ignored.
+    bool feed(char const* bytes, std::size_t in_size)
+    {
+        if (error_ != npos)
+        {
+            size_ += in_size;
+            return false;
+        }
+
+        auto const first = reinterpret_cast<unsigned char const*>(bytes);
+        auto const last = first + in_size;
+        auto p = first;
+        while (p != last)
+        {
+            auto const c = *p;
+            if (need_)
+                // continuation byte
+            {
+                if (c < lo_ || hi_ < c)
+                {
+                    error_ = start_;
+                    break;
+                }
+                lo_ = 0x80;
+                hi_ = 0xBF;
+                --need_;
+                ++p;
+                continue;
+            }
+
+            if (c < 0x80)
+            {
+                ++p;
+                while (last - p >= 8
+                       && !(detail::load64(reinterpret_cast<char const*>(p))
+                            & detail::g_high_bits))
+                {
+                    p += 8;
+                }
+                continue;
+            }
+
+            start_ = size_ + static_cast<std::size_t>(p - first);
+            if (c < 0xC2 || 0xF4 < c)
+            {
+                error_ = start_;
+                break;
+            }
+            need_ = (c < 0xE0) ? 1 : (c < 0xF0) ? 2 : 3;
+            lo_ = (c == 0xE0) ? 0xA0 : (c == 0xF0) ? 0x90 : 0x80;
+            hi_ = (c == 0xED) ? 0x9F : (c == 0xF4) ? 0x8F : 0xBF;
+            ++p;
+        }
+        size_ += in_size;
+        return error_ == npos;
+    }
+
+    bool feed(std::string const& bytes)
+    {
+        return feed(bytes.data(), bytes.size());
+    }
+
+    // valid so far, the last sequence may be incomplete.
+    bool valid() const
+    {
+        return error_ == npos;
+    }
+
+    // valid, and the last sequence is complete.
+    bool finish() const
+    {
+        return error_ == npos && !need_;
+    }
+
+    // offset of the first invalid sequence, npos if none.
+    std::size_t error_offset() const
+    {
+        return error_;
+    }
+
+    // bytes fed
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    // bytes of the incomplete sequence at the end.
+    std::size_t pending() const
+    {
+        return (error_ == npos && need_) ? size_ - start_ : 0;
+    }
+
+    void reset()
+    {
+        size_ = 0;
+        start_ = 0;
+        error_ = npos;
+        need_ = 0;
+        lo_ = 0x80;
+        hi_ = 0xBF;
+    }
+
+private:
+    std::size_t size_;   // bytes fed
+    std::size_t start_;  // offset of the last multi bytes sequence
+    std::size_t error_;
+    unsigned need_;      // continuation bytes to come
+    unsigned char lo_;   // range of the next continuation byte
+    unsigned char hi_;
+};
+
+/*****************************************************************************/
+/* Transcoding Stream Buffer. */
+
+namespace detail
+{
+
+// bytes of complete characters at the front of a block, the rest of it
+// waits for more input. 0 if it's unknown yet.
+inline std::size_t complete_prefix(codepage::type cp
+                                   , char const* p, std::size_t n)
+{
+    auto const u = reinterpret_cast<unsigned char const*>(p);
+
+    using namespace codepage;
+    switch (cp)
+    {
+    case cp_latin1:
+        return n;
+    case cp_ucs2_le:
+    case cp_ucs2_be:
+    {
+        // keep high surrogate with the low one.
+        auto m = n & ~std::size_t(1);
+        if (m >= 2)
+        {
+            auto const hi = u[m - (cp == cp_ucs2_le ? 1 : 2)];
+            m -= (0xD8 <= hi && hi <= 0xDB) ? 2 : 0;
+        }
+        return m;
+    }
+    case cp_utf8:
+    {
+        // back to lead byte of the last sequence.
+        auto i = n;
+        while (i != 0 && n - i < 4 && (u[i - 1] & 0xC0) == 0x80)
+        {
+            --i;
+        }
+        if (i == 0)
+        {
+            return n;
+        }
+        auto const lead = u[i - 1];
+        std::size_t const len = (lead < 0xC0) ? 1 : (lead < 0xE0) ? 2
+            : (lead < 0xF0) ? 3 : 4;
+        return (n - (i - 1) < len) ? i - 1 : n;
+    }
+    case cp_gb2312:
+    case cp_gb18030:
+    {
+        std::size_t i = 0;
+        while (i != n)
+        {
+            std::size_t len = 1;
+            if (0x81 <= u[i] && u[i] <= 0xFE)
+            {
+                if (i + 1 == n)
+                {
+                    break;
+                }
+                len = (cp == cp_gb18030 && 0x30 <= u[i + 1]
+                       && u[i + 1] <= 0x39) ? 4 : 2;
+            }
+            if (n - i < len)
+            {
+                break;
+            }
+            i += len;
+        }
+        return i;
+    }
+    default:
+    {
+        // bytes below '0' (controls, space and most punctuation) are never
+        // part of multi bytes characters in usual ANSI codepages.
+        auto i = n;
+        while (i != 0 && u[i - 1] >= 0x30)
+        {
+            --i;
+        }
+        return i;
+    }
+    }
+}
+
+} // namespace detail
+
+//
+// Stream buffer of wide characters over a byte stream buffer of codepage
+// cp, e.g. write a large report in GB18030 without holding it in memory.
+//
+//     std::ofstream file("report.txt", std::ios::binary);
+//     transcoding_streambuf<codepage::cp_gb18030> buf(file.rdbuf());
+//     std::wostream out(&buf);
+//     out << L"中文" << std::endl;
+//
+// It converts a block at a time both ways and keeps one codec instance,
+// so iconv descriptors are opened once per stream. Characters that can't
+// be converted are handled by policy, strict policy sets badbit of the
+// stream. Output is flushed when a block is full, by pubsync() and on
+// destruction; BOM (if bo is bom::bomb) is written before the first block
+// and skipped if input starts with it.
+//
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+class transcoding_streambuf : public std::wstreambuf
+{
+public:
+    explicit transcoding_streambuf(std::streambuf* sb
+                                   , policy::type po = policy::strict
+                                   , std::string const& replacement
+                                     = std::string()
+                                   , std::size_t block_size
+                                     = detail::g_chunk_size)
+        : sb_(sb)
+        , ci_(detail::codec_impl::create_instance(cp, bom::nobomb
+                                                  , po, replacement))
+        , block_size_((std::max)(block_size, std::size_t(16)))
+        , put_(block_size_)
+        , invalid_(0)
+        , bom_written_(false)
+        , bom_checked_(false)
+    {
+        this->setp(put_.data(), put_.data() + put_.size());
+    }
+
+    transcoding_streambuf(transcoding_streambuf const&) = delete;
+    transcoding_streambuf& operator=(transcoding_streambuf const&) = delete;
+
+    virtual ~transcoding_streambuf()
+    {
+        try
+        {
+            flush(true);
+        }
+        catch (...)
+        {
+        }
+    }
+
+    std::streambuf* rdbuf() const
+    {
+        return sb_;
+    }
+
+    // the number of invalid sequences handled by policy.
+    std::size_t invalid() const
+    {
+        return invalid_;
+    }
+
+protected:
+    virtual int_type overflow(int_type c)
+    {
+        if (!flush(false))
+        {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            *this->pptr() = traits_type::to_char_type(c);
+            this->pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    virtual int sync()
+    {
+        return (flush(false) && sb_->pubsync() != -1) ? 0 : -1;
+    }
+
+    virtual int_type underflow()
+    {
+        while (this->gptr() == this->egptr())
+        {
+            if (!fill())
+            {
+                return traits_type::eof();
+            }
+        }
+        return traits_type::to_int_type(*this->gptr());
+    }
+
+private:
+    // encode put area, a high surrogate waits for the low one unless final.
+    bool flush(bool final)
+    {
+        auto const first = this->pbase();
+        auto n = static_cast<std::size_t>(this->pptr() - first);
+        std::size_t held = 0;
+        if (!final && n && sizeof(wchar_t) == 2
+            && 0xD800 <= static_cast<unsigned>(first[n - 1])
+            && static_cast<unsigned>(first[n - 1]) <= 0xDBFF)
+        {
+            held = 1;
+        }
+        n -= held;
+
+        if (!bom_written_ && n)
+        {
+            bom_written_ = true;
+            auto const b = detail::get_bom(cp);
+            auto const size = static_cast<std::streamsize>(b.first);
+            if (bo == bom::bomb && b.second
+                && sb_->sputn(reinterpret_cast<char const*>(b.second)
+                              , size) != size)
+            {
+                return false;
+            }
+        }
+
+        if (n)
+        {
+            detail::stats_scope scope(stats::wide, cp, sizeof(wchar_t) * n);
+            std::size_t out_size = 0;
+            invalid_ += ci_->encode_impl(
+                first, n, out_size, [this](std::size_t m) -> char*
+                {
+                    bytes_.resize(m);
+                    return &bytes_[0];
+                });
+            scope.done(out_size);
+            auto const size = static_cast<std::streamsize>(out_size);
+            if (sb_->sputn(bytes_.data(), size) != size)
+            {
+                return false;
+            }
+        }
+
+        if (held)
+        {
+            put_[0] = first[n];
+        }
+        this->setp(put_.data(), put_.data() + put_.size());
+        this->pbump(static_cast<int>(held));
+        return true;
+    }
+
+    // decode next block into get area, false at the end of input.
+    bool fill()
+    {
+        auto const carried = raw_.size();
+        raw_.resize(carried + block_size_);
+        auto const got = sb_->sgetn(&raw_[carried]
+                                    , static_cast<std::streamsize>(
+                                        block_size_));
+        raw_.resize(carried + static_cast<std::size_t>(
+                        (std::max)(got, std::streamsize(0))));
+        auto const end = (got <= 0);
+        if (raw_.empty())
+        {
+            return false;
+        }
+
+        std::size_t start = 0;
+        if (!bom_checked_ && bo == bom::bomb)
+        {
+            auto const b = detail::get_bom(cp);
+            if (raw_.size() < b.first && !end)
+            {
+                return true;  // not sure yet
+            }
+            if (b.second && raw_.size() >= b.first
+                && std::equal(b.second, b.second + b.first
+                              , reinterpret_cast<unsigned char const*>(
+                                  raw_.data())))
+            {
+                start = b.first;
+            }
+        }
+        bom_checked_ = true;
+
+        auto m = start + detail::complete_prefix(cp, raw_.data() + start
+                                                 , raw_.size() - start);
+        if (end || (m == start && raw_.size() >= 4 * block_size_))
+            // the rest is invalid, let policy handle it.
+        {
+            m = raw_.size();
+        }
+
+        std::size_t out_size = 0;
+        if (m != start)
+        {
+            detail::stats_scope scope(cp, stats::wide, m - start);
+            invalid_ += ci_->decode_impl(
+                raw_.data() + start, m - start, out_size
+                , [this](std::size_t k) -> wchar_t*
+                {
+                    get_.resize(k);
+                    return &get_[0];
+                });
+            scope.done(sizeof(wchar_t) * out_size);
+        }
+        raw_.erase(0, m);
+
+        auto const first = get_.empty() ? nullptr : &get_[0];
+        this->setg(first, first, first + out_size);
+        return true;
+    }
+
+private:
+    std::streambuf* sb_;
+    std::shared_ptr<detail::codec_impl> ci_;
+    std::size_t block_size_;
+    std::vector<wchar_t> put_;
+    std::string bytes_;  // encoded put area
+    std::string raw_;    // bytes read, incomplete tail is carried
+    std::wstring get_;
+    std::size_t invalid_;
+    bool bom_written_;
+    bool bom_checked_;
+};
+
+/*****************************************************************************/
+/* Display Width. */
+
+namespace detail
+{
+
+// generated from Unicode 14.0 (EastAsianWidth, general category) and the
+// GB18030 mapping: controls, combining marks, format characters and Hangul
+// medial/final jamo are zero width, East Asian wide and fullwidth ones
+// (and unassigned CJK ideographs) are wide, others (ambiguous too) narrow.
+// As in wcwidth, prepended concatenation marks (U+0600-0605 etc.) are
+// narrow and U+3248-324F wide. GB18030 codes have the width of the
+// character iconv (GB18030-2022) maps them to, private use ones included,
+// so GB and UTF-8 text measure the same.
+// 2 bits per character of 256 characters, 0: zero width, 1: narrow, 2: wide.
+CONSTEXPR std::uint8_t g_width_blocks[164][64] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x15, 0x00, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10,
+      0x41, 0x10, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x40, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x15, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x54, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x14, 0x00, 0x14, 0x04, 0x50, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x00, 0x54, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x55, 0x55, 0x51 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x10, 0x00, 0x00, 0x01, 0x01, 0x50, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x54,
+      0x01, 0x00, 0x54, 0x51, 0x01, 0x00, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54,
+      0x01, 0x54, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45 },
+    { 0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54,
+      0x41, 0x15, 0x14, 0x50, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x51, 0x55, 0x55,
+      0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54,
+      0x01, 0x10, 0x54, 0x51, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00 },
+    { 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x14,
+      0x01, 0x54, 0x55, 0x51, 0x55, 0x41, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x54, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x54, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x04,
+      0x54, 0x05, 0x04, 0x50, 0x55, 0x41, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x14,
+      0x55, 0x45, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x54,
+      0x01, 0x54, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x45, 0x55, 0x05, 0x44, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x00, 0x40, 0x55,
+      0x55, 0x15, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x00, 0x00, 0x54,
+      0x55, 0x55, 0x00, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x11, 0x51, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x00, 0x00, 0x40,
+      0x00, 0x04, 0x55, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54,
+      0x55, 0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x04, 0x00, 0x41, 0x41,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x05, 0x54, 0x55, 0x55, 0x55, 0x01, 0x54, 0x55, 0x55,
+      0x45, 0x41, 0x55, 0x51, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x05, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x10, 0x00, 0x50,
+      0x55, 0x45, 0x01, 0x00, 0x00, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x15, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x40, 0x15, 0x54, 0x55, 0x45, 0x55, 0x01, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x14, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x00, 0x40, 0x44, 0x01, 0x00, 0x54, 0x15, 0x00, 0x00, 0x14,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x04, 0x40, 0x54,
+      0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x55, 0x55, 0x55,
+      0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x50, 0x10, 0x50, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x50, 0x11, 0x50, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x05, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x40, 0x00, 0x00, 0x00, 0x04, 0x00, 0x54, 0x51, 0x55, 0x54, 0x50, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x55, 0x55, 0x15, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x40, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x04, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xA5, 0x55, 0x55, 0x55, 0x69, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xA9, 0x56, 0x96, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x69 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x5A, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0xAA, 0xAA, 0xAA, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95,
+      0x55, 0x55, 0x55, 0x55, 0x95, 0x55, 0x55, 0x55, 0x59, 0x55, 0xA5, 0x55, 0x55, 0x55, 0x55, 0x69,
+      0x55, 0x5A, 0x55, 0x65, 0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x65, 0x55, 0xA5, 0x59, 0x65, 0x59 },
+    { 0x55, 0x59, 0xA5, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x66, 0x95, 0x9A, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0xA9, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x56, 0x55, 0x55, 0x95,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x56, 0x59, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x50, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x9A, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x55, 0x55, 0x55 },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0x55 },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x0A, 0xA0, 0xAA, 0xAA, 0xAA, 0x6A,
+      0xA9, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A, 0x81, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA },
+    { 0x55, 0xA9, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xA9, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0x6A, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0x56, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0x6A, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x40, 0x00, 0x00, 0x50,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55 },
+    { 0x45, 0x45, 0x15, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x41, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x50, 0x55, 0x55, 0x15 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x50, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x15, 0x00, 0x00, 0x50, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x56,
+      0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x05, 0x50, 0x50,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x40, 0x41, 0x41, 0x55, 0x55,
+      0x15, 0x55, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x04, 0x14, 0x54, 0x05,
+      0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x45, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x54, 0x51, 0x55, 0x55, 0x55, 0x55 },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x00, 0x00, 0x00, 0x00, 0xAA, 0xAA, 0x5A, 0x55, 0x00, 0x00, 0x00, 0x00, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0x6A, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A, 0xAA, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15 },
+    { 0xA9, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xAA, 0x6A, 0x55, 0x55, 0x55, 0x55, 0x01, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x40, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x01, 0x41, 0x55, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x40, 0x15,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x54, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x05, 0x00, 0x00, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x05, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00,
+      0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x14, 0x54, 0x55, 0x15,
+      0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x40, 0x41, 0x55,
+      0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x01, 0x00, 0x54, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x55, 0x55, 0x55,
+      0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x40,
+      0x55, 0x55, 0x01, 0x14, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x50, 0x04, 0x55, 0x45,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x15, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x54,
+      0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x54, 0x00, 0x54, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00,
+      0x05, 0x44, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x44, 0x15,
+      0x04, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x50, 0x55, 0x10,
+      0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x40, 0x11,
+      0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x51, 0x00, 0x10, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x05, 0x10, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x41, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x44,
+      0x15, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x05, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x01, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x14, 0x40,
+      0x55, 0x15, 0x55, 0x55, 0x01, 0x40, 0x01, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x05, 0x00, 0x00, 0x40, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x40, 0x00, 0x10,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x04, 0x41, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x40, 0x45, 0x10,
+      0x00, 0x10, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x50, 0x11, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x54, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x54, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x54, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x40, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x15, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x15, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xAA, 0x54, 0x55, 0x55, 0x5A, 0x55, 0x55, 0x55 },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x55, 0x55 },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0xAA, 0xAA, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xAA, 0xA9, 0xAA, 0x69 },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x6A, 0x55, 0x55, 0x55, 0x55, 0xAA, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x41, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x50, 0x55, 0x15, 0x00, 0x00, 0x00,
+      0x40, 0x01, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x50, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x05, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x15, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54, 0x55, 0x51, 0x55, 0x55,
+      0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x01, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x14, 0x00, 0x10, 0x04, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x95, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x65, 0xA9, 0xAA, 0x6A, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x6A, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x55,
+      0xAA, 0xAA, 0x56, 0x55, 0x5A, 0x55, 0x55, 0x55, 0xAA, 0x5A, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x56, 0x55, 0x55, 0xA9, 0xAA, 0x9A, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xA6,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0x6A, 0x95, 0xAA, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0x56, 0x56, 0xAA, 0xAA },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A,
+      0xA6, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x96 },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A,
+      0x55, 0x55, 0x95, 0x6A, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x55, 0x55, 0x55, 0x55, 0x65, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x69, 0x55, 0x55, 0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95, 0xAA },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0x5A, 0x55, 0x56, 0x6A, 0xA9, 0x55, 0xA9, 0x55, 0x55, 0x95, 0x56, 0x55, 0xAA, 0xAA, 0x56 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0x55, 0x56, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A, 0xAA,
+      0xAA, 0x9A, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xAA, 0x56, 0xAA, 0x56,
+      0xAA, 0x6A, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x56, 0xAA, 0xAA, 0x6A, 0x55,
+      0xAA, 0x5A, 0x55, 0x55, 0xAA, 0xAA, 0x5A, 0x55, 0xAA, 0xAA, 0x55, 0x55, 0xAA, 0x6A, 0x55, 0x55 },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xA9, 0x55, 0x9A, 0x55, 0xA5, 0xAA, 0xAA, 0xAA,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95, 0x69, 0x55, 0x55, 0x55, 0x55, 0x65 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xA9, 0xAA, 0x6A, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xA9, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xA9, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xA9, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xA9, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x95, 0x5A, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0xA9, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x65, 0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A, 0x55 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x04, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x00, 0x44 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x00, 0x00, 0x00, 0x00,
+      0x50, 0x55, 0x55, 0x55, 0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x40,
+      0x01, 0x40, 0x41, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x00, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x01, 0x00, 0x50, 0x55, 0x15, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x01 },
+    { 0x00, 0x10, 0x10, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x50,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00,
+      0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x44, 0x15, 0x00, 0x40, 0x15, 0x15, 0x00, 0x50, 0x55,
+      0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x15, 0x40, 0x55, 0x15, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x14, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x15, 0x54, 0x41, 0x01, 0x15, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x05, 0x15, 0x55, 0x55, 0x15, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x15, 0x00, 0x41, 0x15, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x10, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x11, 0x40, 0x55, 0x15, 0x55, 0x15, 0x54, 0x55,
+      0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x55, 0x55, 0x15, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x40, 0x55, 0x40, 0x00, 0x55, 0x15, 0x54, 0x55,
+      0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x51, 0x55, 0x54, 0x05, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x41, 0x15, 0x40, 0x55, 0x15, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54, 0x55, 0x40, 0x54, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x15, 0x05, 0x00, 0x54, 0x55, 0x55, 0x01, 0x00, 0x54, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x15, 0x05, 0x00, 0x40, 0x55, 0x55, 0x05, 0x00, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x11, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x00, 0x04, 0x40, 0x50, 0x15, 0x00, 0x00, 0x10, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x55, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x15, 0x40, 0x00, 0x10, 0x14, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55,
+      0x40, 0x55, 0x55, 0x55, 0x15, 0x40, 0x55, 0x55, 0x55, 0x14, 0x54, 0x15, 0x55, 0x55, 0x55, 0x15,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xA5, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0x0A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15,
+      0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x40, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x01, 0x00, 0x55, 0x55, 0x14, 0x00, 0x00, 0x50, 0x55, 0x15,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x50, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x15, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x05, 0x54, 0x41, 0x55, 0x55, 0x54, 0x15, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x41, 0x51 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x04, 0x00,
+      0x44, 0x14, 0x00, 0x40, 0x55, 0x01, 0x00, 0x40, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x00, 0x44, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x01, 0x00, 0x50, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x00, 0x05, 0x01, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x04, 0x15, 0x01, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x05, 0x00, 0x50, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x04, 0x00, 0x00,
+      0x40, 0x00, 0x40, 0x15, 0x55, 0x45, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x50, 0x55, 0x55, 0x55 },
+    { 0x01, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x40, 0x00, 0x00,
+      0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xA5, 0x55, 0x55, 0x55, 0x69, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xA9, 0x56, 0x96, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0xA5, 0x55, 0x55, 0x55, 0x55, 0xA5, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95,
+      0x55, 0x55, 0x55, 0x55, 0x95, 0x55, 0x55, 0x55, 0x59, 0x55, 0xA5, 0x55, 0x55, 0x55, 0x55, 0x69,
+      0x55, 0x5A, 0x55, 0x65, 0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x65, 0x55, 0xA5, 0x59, 0x65, 0x59,
+      0x55, 0x59, 0xA5, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x66, 0x95, 0x9A, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0xA9, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x56, 0x55, 0x55, 0x95,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x56, 0x59, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x50, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xA9, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A, 0x55, 0x55, 0xA5, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xA5, 0xAA, 0x0A, 0xA0, 0xAA, 0xAA, 0xAA,
+      0x5A, 0x6A, 0x81, 0xAA, 0x6A, 0x55, 0xAA, 0x9A, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xA6,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0x5A, 0x55, 0x55, 0xA5, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xA6, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95, 0xAA, 0xAA, 0xAA, 0x56, 0x55, 0xA9, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0x5A, 0xA9, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x01, 0x00, 0x40, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x41, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15,
+      0x15, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x00, 0x00, 0x00, 0x40, 0x55, 0x55, 0x55, 0x54,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x00, 0x00, 0x40, 0x55, 0x55, 0x55, 0xA9, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A, 0x01,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x14, 0x40, 0x41, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x05, 0x05, 0x55, 0x55, 0x55 },
+    { 0x54, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x11, 0x50, 0x50, 0x15, 0x44,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x41, 0x55, 0x15, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x51, 0x45, 0x55, 0x55, 0x55, 0x55, 0xA9,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x56, 0x55, 0x55, 0x01, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xA9, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA },
+    { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+      0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00,
+      0x00, 0xAA, 0x66, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 },
+    { 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x69, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x65, 0x55, 0x55, 0x55, 0x55, 0x01, 0x55, 0x55 }
+};
+
+// block of code point cp >> 8, cp < 0x40000.
+CONSTEXPR std::uint8_t g_width_ucs[1024] = {
+    0, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+    15, 16, 1, 17, 1, 1, 1, 18, 19, 20, 21, 22, 23, 24, 1, 1,
+    25, 1, 1, 26, 1, 27, 28, 29, 1, 1, 1, 30, 31, 32, 33, 34,
+    35, 36, 37, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 39, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 40, 1, 41, 1, 42, 43, 44, 45, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 46, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 38, 38, 47, 1, 1, 48, 49,
+    1, 50, 51, 52, 1, 1, 1, 1, 1, 1, 53, 1, 1, 54, 55, 56,
+    57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 1, 68, 69, 70, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 71, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 72, 73, 1, 1, 1, 74,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 75, 38, 38, 38, 38, 76, 77, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 78,
+    38, 79, 80, 1, 1, 1, 1, 1, 1, 1, 1, 1, 81, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 82,
+    1, 83, 84, 1, 1, 1, 1, 1, 1, 1, 85, 1, 1, 1, 1, 1,
+    86, 73, 87, 1, 1, 1, 1, 1, 88, 89, 1, 1, 1, 1, 1, 1,
+    90, 91, 92, 93, 94, 95, 96, 97, 1, 98, 99, 1, 1, 1, 1, 1,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 100,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 100
+};
+
+// block of GB18030 lead byte - 0x81, indexed by trail byte.
+CONSTEXPR std::uint8_t g_width_gb2[126] = {
+    101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101,
+    101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101,
+    102, 103, 104, 105, 106, 107, 1, 108, 109, 110, 110, 110, 110, 110, 110, 101,
+    101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101,
+    101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101,
+    101, 101, 101, 101, 101, 101, 111, 101, 101, 101, 101, 101, 101, 101, 101, 101,
+    101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101,
+    101, 101, 101, 101, 101, 101, 101, 110, 110, 110, 110, 110, 110, 110
+};
+
+// block of GB18030 four bytes index >> 8, BMP only.
+CONSTEXPR std::uint8_t g_width_gb4[154] = {
+    112, 1, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126,
+    127, 1, 128, 1, 1, 129, 130, 131, 132, 133, 134, 135, 136, 1, 137, 138,
+    1, 139, 140, 141, 142, 143, 1, 1, 144, 145, 146, 147, 148, 149, 150, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 151, 38, 38, 38, 38, 152,
+    1, 153, 154, 155, 156, 157, 158, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 159, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 160, 38, 161, 1, 1, 162, 163
+};
+
+inline unsigned block_width(std::uint8_t block, unsigned i)
+{
+    return (g_width_blocks[block][i >> 2] >> ((i & 3) * 2)) & 3;
+}
+
+// printable ASCII bytes at the front of [p, last), one column each.
+inline std::size_t printable_ascii(char const* p, char const* last)
+{
+    auto const first = p;
+#if defined(YMH_UNA_WITH_AVX2)
+    for ( ; last - p >= 32; p += 32)
+    {
+        // signed compare, high bytes are negative.
+        auto const b = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const*>(p));
+        auto const ok = _mm256_andnot_si256(
+            _mm256_cmpeq_epi8(b, _mm256_set1_epi8(0x7F))
+            , _mm256_cmpgt_epi8(b, _mm256_set1_epi8(0x1F)));
+        auto const mask = static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(ok));
+        if (mask != 0xFFFFFFFFu)
+        {
+            return static_cast<std::size_t>(p - first) + ctz32(~mask);
+        }
+    }
+#endif  // YMH_UNA_WITH_AVX2
+#if defined(YMH_UNA_WITH_SSE2)
+    for ( ; last - p >= 16; p += 16)
+    {
+        auto const b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+        auto const ok = _mm_andnot_si128(
+            _mm_cmpeq_epi8(b, _mm_set1_epi8(0x7F))
+            , _mm_cmpgt_epi8(b, _mm_set1_epi8(0x1F)));
+        auto const mask = static_cast<std::uint32_t>(_mm_movemask_epi8(ok));
+        if (mask != 0xFFFFu)
+        {
+            return static_cast<std::size_t>(p - first) + ctz32(~mask);
+        }
+    }
+#else
+    for ( ; last - p >= 8; p += 8)
+    {
+        // any byte below 0x20, 0x7F or high byte.
+        auto const w = load64(p);
+        auto const del = w ^ 0x7F7F7F7F7F7F7F7FULL;
+        if ((w | ((w - 0x2020202020202020ULL) & ~w)
+             | ((del - 0x0101010101010101ULL) & ~del)) & g_high_bits)
+        {
+            break;
+        }
+    }
+#endif  // YMH_UNA_WITH_SSE2
+    for ( ; p != last; ++p)
+    {
+        auto const c = static_cast<unsigned char>(*p);
+        if (c < 0x20 || c >= 0x7F)
+        {
+            break;
+        }
+    }
+    return static_cast<std::size_t>(p - first);
+}
+
+}  // namespace detail
+
+//
+// Columns of a character on terminals: 0 for controls, combining marks and
+// format characters, 2 for East Asian wide and fullwidth ones, otherwise 1.
+// Unlike wcwidth, it doesn't depend on the locale and controls count 0.
+//
+inline unsigned char_width(char32_t c)
+{
+    if (c < 0x40000)
+    {
+        return detail::block_width(detail::g_width_ucs[c >> 8], c & 0xFF);
+    }
+    // tags and variation selectors supplement.
+    return (c == 0xE0001 || (0xE0020 <= c && c <= 0xE007F)
+            || (0xE0100 <= c && c <= 0xE01EF)) ? 0 : 1;
+}
+
+namespace detail
+{
+
+inline std::size_t display_width_utf8(char const* p, char const* last)
+{
+    std::size_t width = 0;
+    while (p != last)
+    {
+        auto const n = printable_ascii(p, last);
+        width += n;
+        p += n;
+        if (p == last)
+        {
+            break;
+        }
+        if (static_cast<unsigned char>(*p) < 0x80)
+            // control
+        {
+            ++p;
+            continue;
+        }
+        char32_t c = 0;
+        p += next_utf8(reinterpret_cast<unsigned char const*>(p)
+                       , reinterpret_cast<unsigned char const*>(last), c);
+        width += char_width(c);
+    }
+    return width;
+}
+
+// invalid bytes are one column each, like U+FFFD.
+inline std::size_t display_width_gb(char const* p, char const* last
+                                    , bool gb18030)
+{
+    std::size_t width = 0;
+    while (p != last)
+    {
+        auto const n = printable_ascii(p, last);
+        width += n;
+        p += n;
+        if (p == last)
+        {
+            break;
+        }
+
+        auto const u = reinterpret_cast<unsigned char const*>(p);
+        auto const lead = u[0];
+        auto const left = last - p;
+        if (lead < 0x80)
+            // control
+        {
+            ++p;
+            continue;
+        }
+        if (lead == 0x80 || lead == 0xFF || left < 2)
+        {
+            ++width;
+            ++p;
+            continue;
+        }
+
+        auto const trail = u[1];
+        if (0x40 <= trail && trail <= 0xFE && trail != 0x7F)
+        {
+            width += block_width(g_width_gb2[lead - 0x81], trail);
+            p += 2;
+        }
+        else if (gb18030 && 0x30 <= trail && trail <= 0x39 && left >= 4
+                 && 0x81 <= u[2] && u[2] <= 0xFE
+                 && 0x30 <= u[3] && u[3] <= 0x39)
+        {
+            auto const index = ((static_cast<std::uint32_t>(lead - 0x81) * 10
+                                 + (trail - 0x30)) * 126
+                                + (u[2] - 0x81)) * 10 + (u[3] - 0x30);
+            CONSTEXPR std::uint32_t bmp_size = 39420;
+            CONSTEXPR std::uint32_t supplementary = 189000;  // 0x90308130
+            if (index < bmp_size)
+            {
+                width += block_width(g_width_gb4[index >> 8], index & 0xFF);
+            }
+            else if (supplementary <= index
+                     && index - supplementary < 0x100000)
+            {
+                width += char_width(0x10000 + (index - supplementary));
+            }
+            else
+            {
+                ++width;
+            }
+            p += 4;
+        }
+        else
+        {
+            ++width;
+            ++p;
+        }
+    }
+    return width;
+}
+
+inline std::size_t display_width_latin1(char const* p, char const* last)
+{
+    std::size_t width = 0;
+    while (p != last)
+    {
+        auto const n = printable_ascii(p, last);
+        width += n;
+        p += n;
+        if (p == last)
+        {
+            break;
+        }
+        auto const c = static_cast<unsigned char>(*p++);
+        width += (c >= 0xA0);  // C0, DEL and C1 are controls
+    }
+    return width;
+}
+
+}  // namespace detail
+
+//
+// Columns of encoded text on terminals, sum of char_width of characters,
+// e.g. pad cells of a table of mixed CJK and ASCII text.
+//
+//     auto const pad = 20 - display_width<codepage::cp_utf8>(name);
+//
+// UTF-8, GB18030, GB2312 and Latin-1 are measured from bytes directly by
+// tables without decoding, runs of printable ASCII 16 (or 32) bytes at a
+// time; other codepages are decoded character by character.
+//
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline std::size_t display_width(char const* bytes, std::size_t size)
+{
+    using namespace codepage;
+    auto const last = bytes + size;
+    switch (cp)
+    {
+    case cp_utf8:
+        return detail::display_width_utf8(bytes, last);
+    case cp_gb2312:
+        return detail::display_width_gb(bytes, last, false);
+    case cp_gb18030:
+        return detail::display_width_gb(bytes, last, true);
+    case cp_latin1:
+        return detail::display_width_latin1(bytes, last);
+    default:
+        break;
+    }
+
+    std::size_t width = 0;
+    for (char32_t c : basic_codepoint_view<cp, bo>(bytes, size))
+    {
+        width += char_width(c);
+    }
+    return width;
+}
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline std::size_t display_width(std::string const& bytes)
+{
+    return display_width<cp, bo>(bytes.data(), bytes.size());
+}
+
+inline std::size_t display_width(std::wstring const& wstr)
+{
+    std::size_t width = 0;
+    for (std::size_t i = 0; i != wstr.size(); ++i)
+    {
+        auto c = static_cast<char32_t>(wstr[i]);
+        if (sizeof(wchar_t) == 2 && 0xD800 <= c && c <= 0xDBFF
+            && i + 1 != wstr.size())
+            // surrogate pair
+        {
+            auto const lo = static_cast<char32_t>(wstr[i + 1]);
+            if (0xDC00 <= lo && lo <= 0xDFFF)
+            {
+                c = 0x10000 + ((c - 0xD800) << 10) + (lo - 0xDC00);
+                ++i;
+            }
+        }
+        width += char_width(c);
+    }
+    return width;
+}
+
+#if defined(YMH_UNA_WITH_CACHE)
+
+/*****************************************************************************/
+/* Conversion Cache. */
+
+//
+// Define YMH_UNA_WITH_CACHE before include una.hpp to memoize short
+// conversions, e.g. hostnames and field names converted again and again.
+//
+// Results are shared and immutable, entries live in a sharded LRU and
+// the whole cache is bounded by cache::capacity() bytes.
+//
+namespace cache
+{
+
+struct counters
+{
+    std::uint64_t hits;
+    std::uint64_t misses;
+    std::uint64_t evictions;
+    std::uint64_t bypasses;  // input longer than max_input(), or cp_default
+};
+
+}  // namespace cache
+
+namespace detail
+{
+
+// settings and counters shared by all result types.
+class cache_registry
+{
+public:
+    static cache_registry& instance()
+    {
+        static cache_registry registry;
+        return registry;
+    }
+
+    std::atomic<std::size_t> capacity;   // bytes, 0 disables caching
+    std::atomic<std::size_t> max_input;  // bytes
+    std::atomic<std::uint64_t> hits;
+    std::atomic<std::uint64_t> misses;
+    std::atomic<std::uint64_t> evictions;
+    std::atomic<std::uint64_t> bypasses;
+    std::atomic<unsigned> generation;    // bumped by cache::clear()
+
+private:
+    cache_registry()
+    {
+        capacity.store(8 * 1024 * 1024, std::memory_order_relaxed);
+        max_input.store(256, std::memory_order_relaxed);
+        hits.store(0, std::memory_order_relaxed);
+        misses.store(0, std::memory_order_relaxed);
+        evictions.store(0, std::memory_order_relaxed);
+        bypasses.store(0, std::memory_order_relaxed);
+        generation.store(0, std::memory_order_relaxed);
+    }
+};
+
+// conversion tag and input bytes, hashed once.
+struct cache_key
+{
+    std::size_t hash;
+    std::string bytes;
+
+    bool operator==(cache_key const& rhs) const
+    {
+        return hash == rhs.hash && bytes == rhs.bytes;
+    }
+};
+
+struct cache_key_hash
+{
+    std::size_t operator()(cache_key const& key) const
+    {
+        return key.hash;
+    }
+};
+
+inline cache_key make_cache_key(char tag, int from, int to
+                                , bom::type from_bo, bom::type to_bo
+                                , policy::type po, normalize::type nl
+                                , char const* bytes, std::size_t size)
+{
+    cache_key key;
+    key.bytes.reserve(4 + size);
+    key.bytes += tag;
+    key.bytes += static_cast<char>(from);
+    key.bytes += static_cast<char>(to);
+    key.bytes += static_cast<char>((from_bo << 7) | (to_bo << 6)
+                                   | (po << 3) | nl);
+    key.bytes.append(bytes, size);
+    key.hash = std::hash<std::string>()(key.bytes);
+    return key;
+}
+
+template <class T>
+class lru_cache
+{
+public:
+    typedef std::shared_ptr<T const> value_type;
+
+    static lru_cache& instance()
+    {
+        static lru_cache cache;
+        return cache;
+    }
+
+    template <class Convert>
+    value_type get(cache_key&& key, Convert convert)
+    {
+        auto& registry = cache_registry::instance();
+        auto& s = shards_[(key.hash ^ (key.hash >> 16)) % shard_count];
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.sync(registry);
+
+            auto const it = s.index.find(key);
+            if (it != s.index.end())
+            {
+                // move to front as the most recently used.
+                s.lru.splice(s.lru.begin(), s.lru, it->second.pos);
+                registry.hits.fetch_add(1, std::memory_order_relaxed);
+                return it->second.value;
+            }
+        }
+
+        // convert without lock, throw nothing cached.
+        registry.misses.fetch_add(1, std::memory_order_relaxed);
+        value_type value = std::make_shared<T const>(convert());
+
+        CONSTEXPR std::size_t overhead = 96;  // nodes and control block
+        auto const cost = key.bytes.size() + overhead
+            + value->size() * sizeof(typename T::value_type);
+        auto const limit = registry.capacity.load(std::memory_order_relaxed)
+            / shard_count;
+        if (cost > limit)
+        {
+            return value;
+        }
+
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.sync(registry);
+        while (!s.lru.empty() && s.used + cost > limit)
+            // evict the least recently used.
+        {
+            auto const last = s.index.find(*s.lru.back());
+            s.used -= last->second.cost;
+            s.index.erase(last);
+            s.lru.pop_back();
+            registry.evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        auto const rv = s.index.emplace(std::move(key), node());
+        if (!rv.second)
+            // inserted by another thread meanwhile.
+        {
+            return rv.first->second.value;
+        }
+        auto& n = rv.first->second;
+        n.value = value;
+        n.cost = cost;
+        n.pos = s.lru.insert(s.lru.begin(), &rv.first->first);
+        s.used += cost;
+        return value;
+    }
+
+private:
+    static CONSTEXPR std::size_t shard_count = 16;
+
+    // keys are owned by index, their addresses are stable.
+    typedef std::list<cache_key const*> list_type;
+
+    struct node
+    {
+        value_type value;
+        std::size_t cost;
+        typename list_type::iterator pos;
+    };
+
+    struct shard
+    {
+        // drop entries if cache::clear() was called or backends changed
+        // since last access.
+        void sync(cache_registry const& registry)
+        {
+            auto const g = registry.generation.load(std::memory_order_relaxed);
+            auto const b = backend_registry::instance().generation();
+            if (g != generation || b != backends)
+            {
+                index.clear();
+                lru.clear();
+                used = 0;
+                generation = g;
+                backends = b;
+            }
+        }
+
+        std::mutex mutex;
+        list_type lru;  // front is the most recently used
+        std::unordered_map<cache_key, node, cache_key_hash> index;
+        std::size_t used = 0;
+        unsigned generation = 0;
+        unsigned backends = 0;
+    };
+
+    shard shards_[shard_count];
+};
+
+// make_key is called only if the input is short enough. Conversions of
+// cp_default depend on the locale, which may be changed at any time.
+template <class T, class Make, class Convert>
+inline std::shared_ptr<T const>
+cached(bool locale, std::size_t in_size, Make make_key, Convert convert)
+{
+    auto& registry = cache_registry::instance();
+    if (locale || in_size > registry.max_input.load(std::memory_order_relaxed)
+        || !registry.capacity.load(std::memory_order_relaxed))
+    {
+        registry.bypasses.fetch_add(1, std::memory_order_relaxed);
+        return std::make_shared<T const>(convert());
+    }
+    return lru_cache<T>::instance().get(make_key(), convert);
+}
+
+}  // namespace detail
+
+namespace cache
+{
+
+// total bytes of cached entries, approximately. 0 disables caching.
+inline void set_capacity(std::size_t bytes)
+{
+    detail::cache_registry::instance().capacity.store(
+        bytes, std::memory_order_relaxed);
+}
+
+inline std::size_t capacity()
+{
+    return detail::cache_registry::instance().capacity.load(
+        std::memory_order_relaxed);
+}
+
+// longer inputs bypass the cache.
+inline void set_max_input(std::size_t bytes)
+{
+    detail::cache_registry::instance().max_input.store(
+        bytes, std::memory_order_relaxed);
+}
+
+inline std::size_t max_input()
+{
+    return detail::cache_registry::instance().max_input.load(
+        std::memory_order_relaxed);
+}
+
+// drop all entries, counters are kept.
+inline void clear()
+{
+    detail::cache_registry::instance().generation.fetch_add(
+        1, std::memory_order_relaxed);
+}
+
+inline counters snapshot()
+{
+    auto const& registry = detail::cache_registry::instance();
+    counters c;
+    c.hits = registry.hits.load(std::memory_order_relaxed);
+    c.misses = registry.misses.load(std::memory_order_relaxed);
+    c.evictions = registry.evictions.load(std::memory_order_relaxed);
+    c.bypasses = registry.bypasses.load(std::memory_order_relaxed);
+    return c;
+}
+
+inline void reset()
+{
+    auto& registry = detail::cache_registry::instance();
+    registry.hits.store(0, std::memory_order_relaxed);
+    registry.misses.store(0, std::memory_order_relaxed);
+    registry.evictions.store(0, std::memory_order_relaxed);
+    registry.bypasses.store(0, std::memory_order_relaxed);
+}
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG
+          , policy::type po POLICY_DEFAULT_TEMPLATE_ARG>
+inline std::shared_ptr<std::string const> encode(std::wstring const& wstr)
+{
+    auto const in_size = wstr.size() * sizeof(wchar_t);
+    return detail::cached<std::string>(cp == codepage::cp_default, in_size
+                                       , [&]()
+    {
+        return detail::make_cache_key(
+            'e', stats::wide, cp, bom::nobomb, bo, po, normalize::none
+            , reinterpret_cast<char const*>(wstr.data()), in_size);
+    }, [&]()
+    {
+        return una::encode<cp, bo, po>(wstr);
+    });
+}
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG
+          , policy::type po POLICY_DEFAULT_TEMPLATE_ARG
+          , normalize::type nl NORMALIZE_DEFAULT_TEMPLATE_ARG>
+inline std::shared_ptr<std::wstring const> decode(std::string const& bytes)
+{
+    return detail::cached<std::wstring>(cp == codepage::cp_default
+                                        , bytes.size(), [&]()
+    {
+        return detail::make_cache_key(
+            'd', cp, stats::wide, bo, bom::nobomb, po, nl
+            , bytes.data(), bytes.size());
+    }, [&]()
+    {
+        return una::decode<cp, bo, po, nl>(bytes);
+    });
+}
+
+template <codepage::type from_cp CP_DEFAULT_TEMPLATE_ARG
+          , codepage::type to_cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type from_bo BOM_DEFAULT_TEMPLATE_ARG
+          , bom::type to_bo BOM_DEFAULT_TEMPLATE_ARG
+          , policy::type po POLICY_DEFAULT_TEMPLATE_ARG
+          , normalize::type nl NORMALIZE_DEFAULT_TEMPLATE_ARG>
+inline std::shared_ptr<std::string const> convert(std::string const& bytes)
+{
+    return detail::cached<std::string>(from_cp == codepage::cp_default
+                                       || to_cp == codepage::cp_default
+                                       , bytes.size(), [&]()
+    {
+        return detail::make_cache_key(
+            'c', from_cp, to_cp, from_bo, to_bo, po, nl
+            , bytes.data(), bytes.size());
+    }, [&]()
+    {
+        return una::convert<from_cp, to_cp, from_bo, to_bo, po, nl>(bytes);
+    });
+}
+
+}  // namespace cache
+
+#endif  // YMH_UNA_WITH_CACHE
+
+} // namespace una
+
+namespace codepage = una::codepage;
+namespace bom = una::bom;
+namespace policy = una::policy;
+namespace normalize = una::normalize;
+namespace backend = una::backend;
+namespace progress = una::progress;
+#if defined(YMH_UNA_WITH_CACHE)
+namespace cache = una::cache;
+#endif  // YMH_UNA_WITH_CACHE
+#if defined(YMH_UNA_WITH_TABLES) && defined(YMH_UNA_WITH_ICONV)
+namespace tables = una::tables;
+#endif  // YMH_UNA_WITH_TABLES && YMH_UNA_WITH_ICONV
+
+using una::codec;
+using una::encode;
+using una::decode;
+using una::convert;
+
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+using una::basic_literal;
+using una::literal;
+#endif  // __cplusplus >= 201402L
+
+using una::basic_codepoint_view;
+using una::codepoints;
+
+using una::basic_codepoint_index;
+using una::codepoint_index;
+using una::decode_range;
+
+using una::basic_searcher;
+using una::search;
+
+using una::utf8_validator;
+using una::transcoding_streambuf;
+
+using una::char_width;
+using una::display_width;
+
+using una::UnicodeToANSI;
+using una::ANSIToUnicode;
+
+using una::UnicodeToUTF8;
+using una::UTF8ToUnicode;
+
+using una::UnicodeToGB2312;
+using una::GB2312ToUnicode;
+
+} // namespace ymh
+
+/*****************************************************************************/
+/* Others */
+
+namespace ymh
+{
+namespace una
+{
+namespace detail
+{
+namespace utf8
+{
+
+// byte is utf8 character?
+//
+// requires：
+//     - bytes length >= step;
+//     - 1 <= step <= 6.
+//
+// @note ascii if step == 1
+//
+// return step if true else 0.
+inline std::uint8_t step_bytes(char const* bytes, std::size_t /*in_size*/
+                               , std::uint8_t step)
+{
+    // single byte (ascii)
+    //    0xxxxxxx
+    // -> 00000000
+    if (step == 1)
+    {
+        return ((static_cast<unsigned char>(*bytes) >> 7) == 0) ? 1 : 0;
+    }
+
+    // invalid
+    if (step > 6)
+    {
+        return 0;
+    }
+
+    // multi bytes
+    //      110xxxxx 10xxxxxx
+    //  ->  00000110 00000010
+    //
+    // step  = 2
+    // 5     = 7 - step         = 8 - step [x 1] - 1 [x 0]
+    // 0x06  = 2^(step + 1) - 2 = 2^(2 + 1) - 2
+    //
+    //      1110xxxxx 10xxxxxx 10xxxxxx
+    //  ->  000001110 00000010 00000010
+    //
+    // step  = 3
+    // 4     = 7 - step         = 8 - step [x 1] - 1 [x 0] = 5
+    // 0x0E  = 2^(step + 1) - 2 = 2^(3 + 1) - 2
+    if ((static_cast<unsigned char>(*bytes++) >> (7 - step))
+        != static_cast<std::uint8_t>(std::pow(2.0, step + 1) - 2))
+    {
+        return 0;
+    }
+
+    for (std::uint8_t i = 0; i != (step - 1); ++i)
+    {
+        if (static_cast<unsigned char>(*bytes++) >> 6 != 0x02)
+        {
+            return 0;
+        }
+    }
+
+    return step;
+}
+
+inline bool is_utf8(char const* bytes, std::size_t in_size)
+{
+    for (std::size_t i = 0; i != in_size; )
+    {
+        CONSTEXPR std::uint8_t utf8_max_bytes = 6;
+        std::uint8_t const k = (in_size - i > utf8_max_bytes)
+        ? utf8_max_bytes : static_cast<std::uint8_t>(in_size - i);
+
+        for (std::uint8_t j = 1; j <= k; ++j)
+            // [1, utf8_max_bytes]
+        {
+            if (step_bytes(bytes + i, in_size, j))
+            {
+                // @warning quick check:
+                //          comment if (j >= 2) scoped code。
+                // if (j >= 2)
+                // {
+                //   return true;
+                // }
+
+                i += j;
+                break;
+            }
+            else if (j == k)
+            {
+                // @warning relax check
+                return (k < utf8_max_bytes);
+                // return false;
+            }
+        }
+    }
+    return true;
+}
+
+inline bool is_utf8(std::string const& bytes)
+{
+    return is_utf8(bytes.data(), bytes.size());
+}
+
+}  // namespace utf8
+
+namespace latin1
+{
+
+//
+// Latin-1 text has no C1 controls (0x80 - 0x9F), which double byte
+// codepages take as lead bytes, and its accented letters mostly stand
+// alone, while Han of GB2312 and alike are runs of high bytes.
+//
+// @note a guess, it's checked after UTF-8.
+inline bool is_latin1(char const* bytes, std::size_t in_size)
+{
+    std::size_t high = 0;      // bytes 0xA0 - 0xFF
+    std::size_t adjacent = 0;  // high bytes after another one
+    auto prev = false;
+    for (std::size_t i = 0; i != in_size; )
+    {
+        if (in_size - i >= 8 && !(load64(bytes + i) & g_high_bits))
+            // ascii
+        {
+            i += 8;
+            prev = false;
+            continue;
+        }
+
+        auto const c = static_cast<unsigned char>(bytes[i++]);
+        if (c < 0x80)
+        {
+            prev = false;
+            continue;
+        }
+        if (c < 0xA0)
+        {
+            return false;
+        }
+        ++high;
+        adjacent += prev ? 1 : 0;
+        prev = true;
+    }
+    return high && adjacent * 4 <= high;
+}
+
+}  // namespace latin1
+
+// codepage of leading bytes order mark, false if no one.
+inline bool bom_codepage(char const* bytes, std::size_t in_size
+                         , codepage::type& cp)
+{
+    using namespace codepage;
+    static codepage::type const cps[] = { cp_default
+                                          , cp_utf8
+                                          , cp_gb2312
+                                          , cp_gb18030
+                                          , cp_ucs2_le
+                                          , cp_ucs2_be };
+    size_t const cps_size = sizeof(cps) / sizeof(*cps);
+
+    for (size_t i = 0; i != cps_size; ++i)
+    {
+        auto const bom = get_bom(cps[i]);
+        auto const bom_size = bom.first;
+        auto const bom_chars = bom.second;
+
+        if (!bom_chars || in_size < bom_size)
+        {
+            continue;
+        }
+
+        auto p_bytes = bytes;
+        for (auto p_bom = bom_chars; p_bom < bom_chars + bom_size
+             ; ++p_bom, ++p_bytes)
+        {
+            if (*p_bom != static_cast<decltype(*p_bom)>(*p_bytes))
+            {
+                break;
+            }
+        }
+
+        if (static_cast<std::size_t>(p_bytes - bytes) == bom_size)
+        {
+            cp = cps[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+// strictly UTF-8, a truncated last sequence is accepted only if the
+// bytes are a prefix of the text (partial).
+inline bool is_strict_utf8(char const* bytes, std::size_t in_size
+                           , bool partial)
+{
+    utf8_validator v;
+    v.feed(bytes, in_size);
+    return partial ? v.valid() : v.finish();
+}
+
+inline codepage::type hint_codepage(char const* bytes, std::size_t in_size
+                                    , bom::type* bo = nullptr
+                                    , bool partial = false)
+{
+    using namespace codepage;
+
+    // check bom bytes order mark.
+    codepage::type cp = cp_default;
+    if (bom_codepage(bytes, in_size, cp))
+    {
+        if (bo)
+        {
+            *bo = bom::bomb;
+        }
+        return cp;
+    }
+
+    // check content.
+#if defined(_WIN32)
+    if (ucs2_le::is_ucs2_le(bytes, in_size))
+    {
+        if (bo)
+        {
+            *bo = bom::nobomb;
+        }
+        return cp_ucs2_le;
+    }
+#endif  // _WIN32
+
+    if (is_strict_utf8(bytes, in_size, partial))
+    {
+        if (bo)
+        {
+            *bo = bom::nobomb;
+        }
+        return cp_utf8;
+    }
+
+    if (latin1::is_latin1(bytes, in_size))
+    {
+        if (bo)
+        {
+            *bo = bom::nobomb;
+        }
+        return cp_latin1;
+    }
+
+    return cp_default; // can't check codepage
+}
+
+inline codepage::type hint_codepage(std::string const& bytes
+                                    , bom::type* bo = nullptr)
+{
+    return hint_codepage(bytes.data(), bytes.size(), bo);
+}
+
+}  // namespace detail
+
+inline codepage::type hint_codepage(char const* bytes, std::size_t in_size
+                                    , bom::type& bo)
+{
+    return detail::hint_codepage(bytes, in_size, &bo);
+}
+
+inline codepage::type hint_codepage(char const* bytes, std::size_t in_size)
+{
+    return detail::hint_codepage(bytes, in_size);
+}
+
+inline codepage::type hint_codepage(std::string const& bytes, bom::type& bo)
+{
+    return detail::hint_codepage(bytes, &bo);
+}
+
+inline codepage::type hint_codepage(std::string const& bytes)
+{
+    return detail::hint_codepage(bytes);
+}
+
+inline bool is_ascii(char const* bytes, std::size_t in_size)
+{
+    for (std::size_t i = 0; i != in_size; ++i)
+    {
+        if (static_cast<unsigned char>(*bytes++) >> 7)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool is_ascii(std::string const& bytes)
+{
+    return is_ascii(bytes.data(), bytes.size());
+}
+
+namespace detail
+{
+
+// file names aren't input of progress.
+inline std::string file_name(wchar_t const* wfilename)
+{
+    progress_pause pause;
+    return codec(codepage::cp_default, bom::nobomb).encode(wfilename);
+}
+
+}  // namespace detail
+
+template <class CharT>
+inline std::string file_data(CharT const* filename)
+{
+    std::string text;
+
+    std::ifstream ifile;
+    ifile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+
+    try
+    {
+        ifile.open(filename, std::ifstream::in | std::ifstream::binary);
+        std::filebuf* fbuf = ifile.rdbuf();
+        auto const count = detail::progress_counts();
+        do
+        {
+            auto const fbuf_size = fbuf->in_avail();
+            if (fbuf_size < 0)
+            {
+                break;
+            }
+            auto const text_size = text.size();
+            text.resize(text_size
+                        + static_cast<std::string::size_type>(fbuf_size));
+
+            // chunk by chunk, see progress::scope.
+            std::streamsize sget_size = 0;
+            while (sget_size != fbuf_size)
+            {
+                auto const n = (std::min)(
+                    fbuf_size - sget_size
+                    , static_cast<std::streamsize>(detail::g_io_chunk_size));
+                auto const m = fbuf->sgetn((char*)(text.data() + text_size
+                                                   + sget_size), n);
+                sget_size += m;
+                detail::progress_step(static_cast<std::uint64_t>(m), count);
+                if (m != n)
+                {
+                    break;
+                }
+            }
+            if (sget_size != fbuf_size)
+            {
+                text.erase(text_size
+                           + static_cast<std::string::size_type>(sget_size));
+            }
+        } while (fbuf->sgetc() != std::ifstream::traits_type::eof());
+    }
+    catch (std::ifstream::failure const& e)
+    {
+        throw std::system_error(
+            std::make_error_code(std::errc::no_such_file_or_directory)
+            , e.what());
+    }
+
+    return std::move(text);
+}
+
+#if !defined(_MSC_VER)
+template <>
+inline std::string file_data<wchar_t>(wchar_t const* wfilename)
+{
+    return file_data<char>(detail::file_name(wfilename).c_str());
+}
+#endif // !_MSC_VER
+
+inline std::string file_data(std::string const& filename)
+{
+    return file_data(filename.c_str());
+}
+
+inline std::string file_data(std::wstring const& wfilename)
+{
+    return file_data(wfilename.c_str());
+}
+
+template <class T>
+inline std::string file_data(T const& filename, std::error_code& ec)
+{
+    try
+    {
+        return std::move(file_data(filename));
+    }
+    catch (std::system_error const& e)
+    {
+        ec = e.code();
+    }
+    return std::string();
+}
+
+namespace detail
+{
+
+//
+// Bytes without BOM to ASCII compatible codepage in one pass, as
+// hint_codepage and then converting do.
+//
+// ASCII prefix is copied, the rest is validated as UTF-8 chunk by chunk
+// while it is copied (or converted later if cp isn't UTF-8). It falls
+// back to converting the rest from Latin-1 or cp_default at the first
+// invalid one, which is the codepage of raw.
+//
+template <codepage::type cp, bom::type bo, normalize::type nl>
+inline std::string ingest_text(std::string const& raw, codepage::type& from)
+{
+    using namespace codepage;
+    auto const first = raw.data();
+    auto const last = first + raw.size();
+
+    std::string text;
+    text.reserve(raw.size() + 4);
+
+    // CR and LF are never a part of multi bytes character.
+    basic_newline_filter<char> filter(
+        static_cast<normalize::type>(nl & normalize::eol));
+    auto append = [&](char const* b, char const* e)
+    {
+        auto const n = text.size();
+        text.append(b, e);
+        if (filter)
+        {
+            auto const p = &text[0];
+            text.resize(static_cast<std::size_t>(
+                filter(p + n, p + text.size()) - p));
+        }
+    };
+
+    // ascii prefix
+    auto rest = first;
+    while (last - rest >= 8 && !(load64(rest) & g_high_bits))
+    {
+        rest += 8;
+    }
+    while (rest != last && !(static_cast<unsigned char>(*rest) & 0x80))
+    {
+        ++rest;
+    }
+    append(first, rest);
+    auto const prefix_size = text.size();
+
+    // speculate UTF-8, the meter counts raw, conversions of rest don't.
+    progress_call call;
+    progress_meter meter;
+    utf8_validator v;
+    auto p = rest;
+    while (p != last)
+    {
+        auto const limit = (static_cast<std::size_t>(last - p)
+                            > static_cast<std::size_t>(g_chunk_size))
+            ? p + g_chunk_size : last;
+        if (!v.feed(p, static_cast<std::size_t>(limit - p)))
+            // invalid
+        {
+            break;
+        }
+        if (cp == cp_utf8)
+        {
+            append(p, limit);
+        }
+        p = limit;
+        meter(static_cast<std::size_t>(p - first));
+    }
+
+    from = (p == last && v.finish()) ? cp_utf8
+        : latin1::is_latin1(rest, static_cast<std::size_t>(last - rest))
+        ? cp_latin1 : cp_default;
+    if (from == cp)
+    {
+        if (cp != cp_utf8)
+        {
+            append(rest, last);
+        }
+    }
+    else if (rest != last)
+    {
+        text.resize(prefix_size);
+
+        // U+FEFF after ascii prefix isn't leading.
+        auto const rest_nl = static_cast<normalize::type>(
+            (rest == first) ? nl : (nl & normalize::eol));
+        auto const wtext = codec(from, bom::nobomb, policy::strict
+                                 , std::string(), rest_nl)(
+                                     std::string(rest, last));
+        text += codec(cp, bom::nobomb)(wtext);
+    }
+    meter.finish(raw.size());
+
+    auto const bom = get_bom(cp);
+    if (bo == bom::bomb && bom.second && !text.empty())
+    {
+        text.insert(text.begin(), bom.second, bom.second + bom.first);
+    }
+    return text;
+}
+
+// raw of known codepage to cp, as string_text does after detection.
+template <codepage::type cp, bom::type bo, normalize::type nl>
+inline std::string string_text_as(std::string const& raw
+                                  , codepage::type cp_raw, bom::type bo_raw)
+{
+    using namespace codepage;
+    progress_call call;
+#if !defined(_WIN32)
+    if (bo_raw == bom::nobomb && cp != cp_ucs2_le && cp != cp_ucs2_be)
+        // as ingest_text does.
+    {
+        std::string text;
+        if (cp == cp_raw)
+            // CR and LF are never a part of multi bytes character.
+        {
+            text = raw;
+            basic_newline_filter<char> filter(
+                static_cast<normalize::type>(nl & normalize::eol));
+            if (filter && !text.empty())
+            {
+                auto const first = &text[0];
+                text.erase(filter(first, first + text.size()) - first);
+            }
+        }
+        else
+        {
+            text = codec(cp, bom::nobomb)(codec(cp_raw, bom::nobomb
+                                                , policy::strict
+                                                , std::string(), nl)(raw));
+        }
+
+        auto const bom = get_bom(cp);
+        if (bo == bom::bomb && bom.second && !text.empty())
+        {
+            text.insert(text.begin(), bom.second, bom.second + bom.first);
+        }
+        return text;
+    }
+#endif  // !_WIN32
+
+    if (cp == cp_raw && bo == bo_raw)
+    {
+        if (!(nl & normalize::eol))
+        {
+            return raw;
+        }
+        if (cp != cp_ucs2_le && cp != cp_ucs2_be)
+            // CR and LF are never a part of multi bytes character.
+        {
+            std::string text(raw);
+            basic_newline_filter<char> filter(normalize::eol);
+            auto const first = &text[0];
+            text.erase(filter(first, first + text.size()) - first);
+            return text;
+        }
+    }
+    return codec(cp, bo)(codec(cp_raw, bo_raw, policy::strict
+                               , std::string(), nl)(raw));
+}
+
+// cp_raw and bo_raw: codepage of raw detected.
+template <codepage::type cp, bom::type bo, normalize::type nl>
+inline std::string string_text(std::string const& raw
+                               , codepage::type& cp_raw, bom::type& bo_raw)
+{
+    progress_call call;
+#if !defined(_WIN32)
+    codepage::type cp_bom = codepage::cp_default;
+    if (cp != codepage::cp_ucs2_le && cp != codepage::cp_ucs2_be
+        && !bom_codepage(raw.data(), raw.size(), cp_bom))
+        // UCS-2 is checked before UTF-8 on Windows only.
+    {
+        bo_raw = bom::nobomb;
+        return ingest_text<cp, bo, nl>(raw, cp_raw);
+    }
+#endif  // !_WIN32
+
+    bo_raw = bom::nobomb;
+    cp_raw = hint_codepage(raw, &bo_raw);
+    return string_text_as<cp, bo, nl>(raw, cp_raw, bo_raw);
+}
+
+}  // namespace detail
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG
+          , normalize::type nl NORMALIZE_DEFAULT_TEMPLATE_ARG>
+inline std::string string_text(std::string const& raw)
+{
+    codepage::type cp_raw = codepage::cp_default;
+    bom::type bo_raw = bom::nobomb;
+    return detail::string_text<cp, bo, nl>(raw, cp_raw, bo_raw);
+}
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG
+          , normalize::type nl NORMALIZE_DEFAULT_TEMPLATE_ARG>
+inline std::string
+string_text(std::string const& raw, std::error_code& ec)
+{
+    try
+    {
+        return std::move(string_text<cp, bo, nl>(raw));
+    }
+    catch (std::system_error const& e)
+    {
+        ec = e.code();
+    }
+    return std::string();
+}
+
+inline std::wstring wstring_text(std::string const& raw
+                                 , normalize::type nl = normalize::none)
+{
+    bom::type bo = codec::nobomb;
+    auto const cp = hint_codepage(raw, bo);
+    return std::move(codec(cp, bo, policy::strict, std::string(), nl)(raw));
+}
+
+inline std::wstring wstring_text(std::string const& raw, std::error_code& ec
+                                 , normalize::type nl = normalize::none)
+{
+    try
+    {
+        return std::move(wstring_text(raw, nl));
+    }
+    catch (std::system_error const& e)
+    {
+        ec = e.code();
+    }
+    return std::wstring();
+}
+
+/*****************************************************************************/
+/* Detection Cache. */
+
+//
+// Define YMH_UNA_WITH_DETECTION_CACHE before include una.hpp to remember the
+// detected codepage of files, file_text of an unchanged file converts it
+// without detection then. POSIX only.
+//
+// Files are identified by (device, inode, size, mtime), records are kept in
+// a small file shared by processes, detection::path().
+//
+#if defined(YMH_UNA_WITH_DETECTION_CACHE) && !defined(_WIN32)
+
+namespace detection
+{
+
+struct counters
+{
+    std::uint64_t hits;
+    std::uint64_t misses;  // detected and recorded
+};
+
+}  // namespace detection
+
+namespace detail
+{
+
+struct file_identity
+{
+    std::uint64_t dev;
+    std::uint64_t ino;
+    std::uint64_t size;
+    std::int64_t mtime;  // nanoseconds
+};
+
+inline bool stat_identity(std::string const& filename, file_identity& id)
+{
+    struct stat st;
+    if (::stat(filename.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+    {
+        return false;
+    }
+    id.dev = static_cast<std::uint64_t>(st.st_dev);
+    id.ino = static_cast<std::uint64_t>(st.st_ino);
+    id.size = static_cast<std::uint64_t>(st.st_size);
+#if defined(__APPLE__)
+    auto const& ts = st.st_mtimespec;
+#else
+    auto const& ts = st.st_mtim;
+#endif  // __APPLE__
+    id.mtime = static_cast<std::int64_t>(ts.tv_sec) * 1000000000
+        + static_cast<std::int64_t>(ts.tv_nsec);
+    return true;
+}
+
+// open addressing table of records in a shared mapped file.
+class detection_store
+{
+public:
+    static CONSTEXPR std::uint32_t slot_count = 4096;
+    static CONSTEXPR std::uint32_t probe_count = 8;
+
+    // written check last, a torn record fails check.
+    struct slot
+    {
+        file_identity id;
+        std::uint32_t value;  // cp << 8 | bo
+        std::uint32_t check;  // 0 if empty
+    };
+
+    struct layout
+    {
+        char magic[8];        // "UNADET1"
+        std::uint32_t order;  // 0x01020304
+        std::uint32_t count;  // of slots
+        slot slots[slot_count];
+    };
+
+    static detection_store& instance()
+    {
+        static detection_store store;
+        return store;
+    }
+
+    ~detection_store()
+    {
+        unmap();
+    }
+
+    std::string path()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return path_;
+    }
+
+    void set_path(std::string const& path)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        unmap();
+        path_ = path;
+    }
+
+    bool find(file_identity const& id, codepage::type& cp, bom::type& bo)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!map())
+        {
+            return false;
+        }
+        auto const home = index(id);
+        for (std::uint32_t i = 0; i != probe_count; ++i)
+        {
+            auto const& s = map_->slots[(home + i) % slot_count];
+            if (s.check && s.check == checksum(s) && same(s.id, id))
+            {
+                cp = static_cast<codepage::type>(s.value >> 8);
+                bo = static_cast<bom::type>(s.value & 0xFF);
+                hits.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // replace record of the same file, or the oldest slot of probes.
+    void insert(file_identity const& id, codepage::type cp, bom::type bo)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!map())
+        {
+            return ;
+        }
+        auto const home = index(id);
+        auto target = &map_->slots[home];
+        for (std::uint32_t i = 0; i != probe_count; ++i)
+        {
+            auto& s = map_->slots[(home + i) % slot_count];
+            if (!s.check || s.check != checksum(s)
+                || (s.id.dev == id.dev && s.id.ino == id.ino))
+            {
+                target = &s;
+                break;
+            }
+            if (s.id.mtime < target->id.mtime)
+            {
+                target = &s;
+            }
+        }
+
+        target->check = 0;
+        target->id = id;
+        target->value = static_cast<std::uint32_t>(cp) << 8
+            | static_cast<std::uint32_t>(bo);
+        target->check = checksum(*target);
+        misses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (map())
+        {
+            std::memset(map_->slots, 0, sizeof(map_->slots));
+        }
+    }
+
+    std::atomic<std::uint64_t> hits;
+    std::atomic<std::uint64_t> misses;
+
+private:
+    detection_store()
+        : path_(user_cache_directory())
+    {
+        if (!path_.empty())
+        {
+            path_ += "/una-detect.bin";
+        }
+        hits.store(0, std::memory_order_relaxed);
+        misses.store(0, std::memory_order_relaxed);
+    }
+
+    static std::uint64_t mix(std::uint64_t h, std::uint64_t v)
+    {
+        // splitmix64 finalizer
+        h ^= v + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+        return h ^ (h >> 31);
+    }
+
+    static std::uint32_t index(file_identity const& id)
+    {
+        return static_cast<std::uint32_t>(mix(mix(0, id.dev), id.ino)
+                                          % slot_count);
+    }
+
+    static std::uint32_t checksum(slot const& s)
+    {
+        auto h = mix(mix(mix(mix(mix(0, s.id.dev), s.id.ino), s.id.size)
+                         , static_cast<std::uint64_t>(s.id.mtime)), s.value);
+        return static_cast<std::uint32_t>(h) | 1;
+    }
+
+    static bool same(file_identity const& a, file_identity const& b)
+    {
+        return a.dev == b.dev && a.ino == b.ino
+            && a.size == b.size && a.mtime == b.mtime;
+    }
+
+    // map file once, null if it can't.
+    layout* map()
+    {
+        if (map_ || tried_)
+        {
+            return map_;
+        }
+        tried_ = true;
+        if (path_.empty())
+        {
+            return nullptr;
+        }
+
+        auto const slash = path_.find_last_of('/');
+        if (slash != std::string::npos && slash != 0)
+        {
+            ::mkdir(path_.substr(0, slash).c_str(), 0700);
+        }
+        auto const fd = ::open(path_.c_str(), O_RDWR | O_CREAT, 0600);
+        if (fd == -1)
+        {
+            return nullptr;
+        }
+
+        // other processes size and initialize the same file.
+        struct stat st;
+        void* addr = MAP_FAILED;
+        if (::flock(fd, LOCK_EX) == 0
+            && ::fstat(fd, &st) == 0
+            && (st.st_size == sizeof(layout)
+                || ::ftruncate(fd, sizeof(layout)) == 0))
+        {
+            addr = ::mmap(nullptr, sizeof(layout), PROT_READ | PROT_WRITE
+                          , MAP_SHARED, fd, 0);
+        }
+        if (addr != MAP_FAILED)
+        {
+            map_ = static_cast<layout*>(addr);
+            if (std::memcmp(map_->magic, "UNADET1", sizeof(map_->magic))
+                || map_->order != 0x01020304 || map_->count != slot_count)
+                // new or foreign file
+            {
+                std::memset(map_, 0, sizeof(layout));
+                std::memcpy(map_->magic, "UNADET1", sizeof(map_->magic));
+                map_->order = 0x01020304;
+                map_->count = slot_count;
             }
         }
+        ::close(fd);  // releases the lock
+        return map_;
     }
 
-    virtual void decode_impl(char const* bytes, int in_size, int& out_size
-                             , codec_impl::alloc4de_t const& allocator) const
+    void unmap()
     {
-        auto const bom_size = this->get_bom().first;
-        auto const bom_chars = this->get_bom().second;
-        if (bom_chars && in_size >= bom_size)
-            // skip bom chars
+        if (map_)
         {
-            auto p_bytes = bytes;
-            for (auto p_bom = bom_chars
-                 ; p_bom < bom_chars + bom_size
-                 ; ++p_bom, ++p_bytes)
-            {
-                if (*p_bom != static_cast<decltype(*p_bom)>(*p_bytes))
-                {
-                    break;
-                }
-            }
-            if (p_bytes - bytes == bom_size)
-            {
-                bytes   += bom_size;
-                in_size -= bom_size;
-            }
+            ::munmap(map_, sizeof(layout));
         }
+        map_ = nullptr;
+        tried_ = false;
+    }
 
-        wchar_t* out = nullptr;
-        for (out_size = 0; !out && in_size; )
-            // exit if in_size == 0
+private:
+    std::mutex mutex_;
+    std::string path_;
+    layout* map_ = nullptr;
+    bool tried_ = false;
+};
+
+//
+// Text of file, the codepage is looked up by file identity first.
+//
+// detect(raw, cp_raw, bo_raw) converts and reports codepage of raw,
+// convert(raw, cp_raw, bo_raw) converts raw of known codepage. It detects
+// again if a recorded codepage fails.
+//
+template <class Detect, class Convert>
+inline auto cached_file_text(std::string const& filename
+                             , Detect const& detect, Convert const& convert)
+    -> decltype(detect(std::string(), std::declval<codepage::type&>()
+                       , std::declval<bom::type&>()))
+{
+    progress_call call;
+    auto& store = detection_store::instance();
+
+    file_identity id;
+    auto const known = stat_identity(filename, id);
+    auto const raw = file_data(filename);
+
+    auto cp_raw = codepage::cp_default;
+    auto bo_raw = bom::nobomb;
+    if (known && store.find(id, cp_raw, bo_raw))
+    {
+        try
         {
-            if (out_size != 0)
-            {
-                out = allocator(out_size);
-            }
-            else if (out_size == 0)
-                // calculate out buffer size.
-            {
-                // perhaps too large, but that's OK
-                CONSTEXPR auto ratio = 3;
-                out_size = in_size * ratio;
-                continue ;
-            }
+            return convert(raw, cp_raw, bo_raw);
+        }
+        catch (std::system_error const&)
+        {
+        }
+    }
 
-            if (this->cp_ == codepage::cp_default)
-                // ANSI to Unicode
-            {
-                typedef char from_type;
-                typedef wchar_t to_type;
-                typedef std::codecvt<to_type
-                                     , from_type, std::mbstate_t> cvt_facet;
+    auto text = detect(raw, cp_raw, bo_raw);
+    if (known)
+    {
+        store.insert(id, cp_raw, bo_raw);
+    }
+    return text;
+}
 
-                std::locale loc("");
-                auto& cvt = std::use_facet<cvt_facet>(loc);
-                for ( ; ; )
-                {
-                    from_type const* fb = bytes;
-                    from_type const* fe = bytes + in_size;
-                    from_type const* fn = nullptr;
+}  // namespace detail
+
+namespace detection
+{
+
+// file of records, empty to disable. $XDG_CACHE_HOME/una-detect.bin or
+// $HOME/.cache/una-detect.bin by default.
+inline void set_path(std::string const& path)
+{
+    detail::detection_store::instance().set_path(path);
+}
+
+inline std::string path()
+{
+    return detail::detection_store::instance().path();
+}
+
+// forget all records, of other processes too.
+inline void clear()
+{
+    detail::detection_store::instance().clear();
+}
+
+inline counters snapshot()
+{
+    auto const& store = detail::detection_store::instance();
+    counters c;
+    c.hits = store.hits.load(std::memory_order_relaxed);
+    c.misses = store.misses.load(std::memory_order_relaxed);
+    return c;
+}
+
+}  // namespace detection
+
+#endif  // YMH_UNA_WITH_DETECTION_CACHE && !_WIN32
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG
+          , normalize::type nl NORMALIZE_DEFAULT_TEMPLATE_ARG>
+inline std::string file_text(std::string const& filename)
+{
+#if defined(YMH_UNA_WITH_DETECTION_CACHE) && !defined(_WIN32)
+    return detail::cached_file_text(filename
+        , &detail::string_text<cp, bo, nl>
+        , &detail::string_text_as<cp, bo, nl>);
+#else
+    detail::progress_call call;
+    auto const text_raw = file_data(filename);
+    return std::move(string_text<cp, bo, nl>(text_raw));
+#endif  // YMH_UNA_WITH_DETECTION_CACHE && !_WIN32
+}
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG
+          , normalize::type nl NORMALIZE_DEFAULT_TEMPLATE_ARG>
+inline std::string
+file_text(std::string const& filename, std::error_code& ec)
+{
+#if defined(YMH_UNA_WITH_DETECTION_CACHE) && !defined(_WIN32)
+    try
+    {
+        return file_text<cp, bo, nl>(filename);
+    }
+    catch (std::system_error const& e)
+    {
+        ec = e.code();
+    }
+    return std::string();
+#else
+    detail::progress_call call;
+    auto const text_raw = file_data(filename, ec);
+    return std::move(string_text<cp, bo, nl>(text_raw, ec));
+#endif  // YMH_UNA_WITH_DETECTION_CACHE && !_WIN32
+}
+
+inline std::wstring file_text(std::wstring const& wfilename
+                              , normalize::type nl = normalize::none)
+{
+#if defined(YMH_UNA_WITH_DETECTION_CACHE) && !defined(_WIN32)
+    auto const convert = [nl](std::string const& raw
+                              , codepage::type cp_raw, bom::type bo_raw)
+    {
+        return codec(cp_raw, bo_raw, policy::strict, std::string(), nl)(raw);
+    };
+    return detail::cached_file_text(detail::file_name(wfilename.c_str())
+        , [&](std::string const& raw
+              , codepage::type& cp_raw, bom::type& bo_raw)
+        {
+            cp_raw = hint_codepage(raw, bo_raw);
+            return convert(raw, cp_raw, bo_raw);
+        }, convert);
+#else
+    detail::progress_call call;
+    auto const text_raw = file_data(wfilename);
+    return std::move(wstring_text(text_raw, nl));
+#endif  // YMH_UNA_WITH_DETECTION_CACHE && !_WIN32
+}
+
+inline std::wstring
+file_text(std::wstring const& wfilename, std::error_code& ec
+          , normalize::type nl = normalize::none)
+{
+#if defined(YMH_UNA_WITH_DETECTION_CACHE) && !defined(_WIN32)
+    try
+    {
+        return file_text(wfilename, nl);
+    }
+    catch (std::system_error const& e)
+    {
+        ec = e.code();
+    }
+    return std::wstring();
+#else
+    detail::progress_call call;
+    auto const text_raw = file_data(wfilename, ec);
+    return std::move(wstring_text(text_raw, ec, nl));
+#endif  // YMH_UNA_WITH_DETECTION_CACHE && !_WIN32
+}
+
+inline size_t save_file_data(std::string const& filename
+                             , std::string const& data
+                             , std::ios_base::openmode mode
+                             = std::ios_base::out|std::ios_base::binary)
+{
+    std::ofstream ofile;
+    ofile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+
+    try
+    {
+        ofile.open(filename.c_str(), mode);
+        auto const count = detail::progress_counts();
+        for (std::size_t i = 0; i != data.size(); )
+            // chunk by chunk, see progress::scope.
+        {
+            auto const n = (std::min)(
+                data.size() - i
+                , static_cast<std::size_t>(detail::g_io_chunk_size));
+            ofile.write(data.data() + i, static_cast<std::streamsize>(n));
+            detail::progress_step(n, count);
+            i += n;
+        }
+        ofile.close();
+    }
+    catch (std::ofstream::failure const& e)
+    {
+        throw std::system_error(
+            std::make_error_code(std::errc::no_such_file_or_directory)
+            , e.what());
+    }
+    return data.size();
+}
+
+inline size_t save_file_data(std::wstring const& wfilename
+                             , std::string const& data
+                             , std::ios_base::openmode mode
+                             = std::ios_base::out|std::ios_base::binary)
+{
+    return save_file_data(detail::file_name(wfilename.c_str()), data, mode);
+}
+
+template <class T>
+inline size_t save_file_data(T const& filename
+                             , std::string const& data
+                             , std::error_code& ec
+                             , std::ios_base::openmode mode
+                             = std::ios_base::out|std::ios_base::binary)
+{
+    try
+    {
+        return save_file_data(filename, data, mode);
+    }
+    catch (std::system_error const& e)
+    {
+        ec = e.code();
+    }
+    return 0U;
+}
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline size_t save_file_text(std::string const& filename
+                             , std::string const& text
+                             , std::ios_base::openmode mode
+                             = std::ios_base::out|std::ios_base::binary)
+{
+    detail::progress_call call;
+    std::string const text_en = convert<codepage::cp_default, cp
+                                        , bom::bomb, bo>(text);
+    return save_file_data(filename, text_en, mode);
+}
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline size_t save_file_text(std::string const& filename
+                             , std::string const& text
+                             , std::error_code& ec
+                             , std::ios_base::openmode mode
+                             = std::ios_base::out|std::ios_base::binary)
+{
+    try
+    {
+        return save_file_text<cp, bo>(filename, text, mode);
+    }
+    catch (std::system_error const& e)
+    {
+        ec = e.code();
+    }
+    return 0U;
+}
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline size_t save_file_text(std::wstring const& wfilename
+                             , std::wstring const& wtext
+                             , std::ios_base::openmode mode
+                             = std::ios_base::out|std::ios_base::binary)
+{
+    detail::progress_call call;
+    std::string const text_en = encode<cp, bo>(wtext);
+    return save_file_data(wfilename, text_en, mode);
+}
+
+template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
+          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
+inline size_t save_file_text(std::wstring const& wfilename
+                             , std::wstring const& wtext
+                             , std::error_code& ec
+                             , std::ios_base::openmode mode
+                             = std::ios_base::out|std::ios_base::binary)
+{
+    try
+    {
+        return save_file_text<cp, bo>(wfilename, wtext, mode);
+    }
+    catch (std::system_error const& e)
+    {
+        ec = e.code();
+    }
+    return 0U;
+}
+
+
+/*****************************************************************************/
+/* Coroutine Pipeline. */
+
+//
+// Read, detect, decode, encode and write files as C++20 coroutines, stages
+// are connected by bounded channels and run on small thread pools, so one
+// file's disk reads overlap with another's conversion and thousands of
+// files need a few threads only.
+//
+//     pipeline::executor io(4), cpu(2);
+//     std::vector<pipeline::task<std::uint64_t>> jobs;
+//     for (auto const& f : files)
+//     {
+//         jobs.push_back(pipeline::transcode_file<codepage::cp_gb18030>(
+//             io, cpu, f, f + ".gb18030"));
+//     }
+//     auto written = pipeline::sync_wait(pipeline::when_all(std::move(jobs)));
+//
+// Executors must outlive the tasks running on them.
+//
+#if defined(__cpp_impl_coroutine)
+
+namespace pipeline
+{
+
+// fixed pool of threads resuming coroutines.
+class executor
+{
+public:
+    explicit executor(std::size_t threads
+                      = (std::max)(2u, std::thread::hardware_concurrency()))
+        : stop_(false)
+    {
+        for (std::size_t i = 0; i != (std::max)(threads, std::size_t(1)); ++i)
+        {
+            threads_.emplace_back([this] { run(); });
+        }
+    }
+
+    executor(executor const&) = delete;
+    executor& operator=(executor const&) = delete;
 
-                    to_type* tb = const_cast<to_type*>(out);
-                    to_type* te = const_cast<to_type*>(out + out_size);
-                    to_type* tn = nullptr;
+    ~executor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& t : threads_)
+        {
+            t.join();
+        }
+    }
 
-                    std::mbstate_t state = std::mbstate_t();
-                    auto result = cvt.in(state, fb, fe, fn, tb, te, tn);
-                    if (result == cvt_facet::ok || result == cvt_facet::noconv)
-                    {
-                        out_size = tn - tb;
-                        return ;
-                    }
-                    else if (result == cvt_facet::partial)
-                    {
-                        out_size += BUFSIZ;
-                        out = allocator(out_size);
-                        continue;
-                    }
+    void post(std::coroutine_handle<> h)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(h);
+        }
+        cv_.notify_one();
+    }
 
-                    // failed
-                    throw std::system_error(
-                        std::make_error_code(std::errc::illegal_byte_sequence)
-                        , "std::codecvt for encode");
-                }
-                return ;
+    // co_await executor.schedule() to continue on a thread of the pool.
+    auto schedule()
+    {
+        struct awaiter
+        {
+            executor* ex;
+
+            bool await_ready() const noexcept
+            {
+                return false;
             }
 
-            // open
-            auto cd = ::iconv_open(default_wide_charset().c_str()
-                                   , to_iconv_codepage(this->cp_).c_str());
-            if (cd == (iconv_t)(-1))
+            void await_suspend(std::coroutine_handle<> h)
             {
-                throw std::system_error(
-                    std::error_code(errno, std::system_category())
-                    , "iconv_open for decode");
+                ex->post(h);
             }
 
-            // iconv
-            char* inbuf = (char*)bytes;
-            size_t inbytesleft = in_size;
-            char* outbuf = (char*)out;
-            size_t outbytesleft = out_size * sizeof(wchar_t);
+            void await_resume() const noexcept
+            {}
+        };
+        return awaiter{ this };
+    }
 
-            ::iconv(cd, nullptr, nullptr, nullptr, nullptr);
-            for ( ; ; )
+private:
+    void run()
+    {
+        for ( ; ; )
+        {
+            std::coroutine_handle<> h;
             {
-                auto rv = ::iconv(cd
-                                  , &inbuf, &inbytesleft
-                                  , &outbuf, &outbytesleft);
-                if (rv == static_cast<size_t>(-1))
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+                if (queue_.empty())
                 {
-                    if (errno == E2BIG)
-                        // outbuf is too small, increment its size.
-                    {
-                        outbuf = (char*)allocator(out_size + BUFSIZ);
-                        outbuf += (out_size * sizeof(wchar_t) - outbytesleft);
-                        outbytesleft += BUFSIZ * sizeof(wchar_t);
-                        out_size += BUFSIZ;
-                        continue;
-                    }
-
-                    ::iconv_close(cd);
-                    throw std::system_error(
-                        std::error_code(errno, std::system_category())
-                        , "iconv for decode");
+                    return;
                 }
-
-                out_size -= outbytesleft / sizeof(wchar_t);
-                break;
-            }
-
-            // close
-            if (::iconv_close(cd) == -1)
-            {
-                throw std::system_error(
-                    std::error_code(errno, std::system_category())
-                    , "iconv_close for decode");
+                h = queue_.front();
+                queue_.pop_front();
             }
+            h.resume();
         }
     }
-};
 
-} // namespace detail
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::coroutine_handle<>> queue_;
+    std::vector<std::thread> threads_;
+    bool stop_;
+};
 
-#endif // YMH_UNA_WITH_ICONV
+template <class T = void>
+class task;
 
-/*****************************************************************************/
-/* Create Codec Implement Instance. */
+}  // namespace pipeline
 
 namespace detail
 {
 
-inline std::shared_ptr<codec_impl>
-codec_impl::create_instance(codepage::type cp, bom::type bo)
+class task_promise_base
 {
-#if defined(_WIN32) || defined(_MSC_VER)
-    typedef win_impl codec_type;
-#elif defined(YMH_UNA_WITH_ICONV)
-    typedef iconv_impl codec_type;
-#else
-#   error requires include <iconv.h> before una.hpp
-#endif // _WIN32 || _MSC_VER
-    return std::make_shared<codec_type>(cp, bo);
-}
+public:
+    struct final_awaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
 
-} // namespace detail
+        template <class Promise>
+        std::coroutine_handle<>
+        await_suspend(std::coroutine_handle<Promise> h) noexcept
+        {
+            auto const c = h.promise().continuation_;
+            return c ? c : std::noop_coroutine();
+        }
 
-/*****************************************************************************/
-/* Convenient User Interface. */
+        void await_resume() const noexcept
+        {}
+    };
 
-template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
-          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline std::string encode(std::wstring const& wstr)
-{
-    return codec(cp, bo)(wstr);
-}
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
 
-template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
-          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline codec::char_ptr encode(wchar_t const* wstr, int in_size, int& out_size)
-{
-    return std::move(codec(cp, bo)(wstr, in_size, out_size));
-}
+    final_awaiter final_suspend() const noexcept
+    {
+        return {};
+    }
 
-template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
-          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline std::wstring decode(std::string const& bytes)
-{
-    return codec(cp, bo)(bytes);
-}
+    void unhandled_exception() noexcept
+    {
+        error_ = std::current_exception();
+    }
 
-template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
-          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline codec::wchar_ptr decode(char const* bytes, int in_size, int& out_size)
-{
-    return std::move(codec(cp, bo)(bytes, in_size, out_size));
-}
+    std::coroutine_handle<> continuation_;
+    std::exception_ptr error_;
+};
 
-template <codepage::type from_cp CP_DEFAULT_TEMPLATE_ARG
-          , codepage::type to_cp CP_DEFAULT_TEMPLATE_ARG
-          , bom::type from_bo BOM_DEFAULT_TEMPLATE_ARG
-          , bom::type to_bo BOM_DEFAULT_TEMPLATE_ARG
-#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
-, typename std::enable_if<
-    from_cp != to_cp || from_bo != to_bo, int>::type = 0 >
-#else
->
-#endif
-inline codec::char_ptr convert(char const* bytes, int in_size, int& out_size)
+template <class T>
+class task_promise : public task_promise_base
 {
-    auto p = decode<from_cp, from_bo>(bytes, in_size, out_size);
-    return encode<to_cp, to_bo>(p.get(), out_size, out_size);
-}
+public:
+    pipeline::task<T> get_return_object();
 
-#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
-template <codepage::type from_cp CP_DEFAULT_TEMPLATE_ARG
-          , codepage::type to_cp CP_DEFAULT_TEMPLATE_ARG
-          , bom::type from_bo BOM_DEFAULT_TEMPLATE_ARG
-          , bom::type to_bo BOM_DEFAULT_TEMPLATE_ARG
-          , typename std::enable_if<
-                from_cp == to_cp && from_bo == to_bo, int>::type = 0>
-inline codec::char_ptr convert(char const* bytes, int in_size, int& out_size)
-{
-    // TODO: have better ?
-    codec::char_ptr to(new char[in_size]);
-    std::copy(bytes, bytes + in_size, to.get());
-    out_size = in_size;
-    return std::move(to);
-}
-#else
-// need c++11
-#endif
+    template <class U>
+    void return_value(U&& value)
+    {
+        value_.emplace(std::forward<U>(value));
+    }
 
-template <codepage::type from_cp CP_DEFAULT_TEMPLATE_ARG
-          , codepage::type to_cp CP_DEFAULT_TEMPLATE_ARG
-          , bom::type from_bo BOM_DEFAULT_TEMPLATE_ARG
-          , bom::type to_bo BOM_DEFAULT_TEMPLATE_ARG
-#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
-, typename std::enable_if<
-    from_cp != to_cp || from_bo != to_bo, int>::type = 0>
-#else
->
-#endif
-inline std::string convert(std::string const& bytes)
-{
-    return encode<to_cp, to_bo>(decode<from_cp, from_bo>(bytes));
-}
+    T result()
+    {
+        if (error_)
+        {
+            std::rethrow_exception(error_);
+        }
+        return std::move(*value_);
+    }
 
-#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
-template <codepage::type from_cp CP_DEFAULT_TEMPLATE_ARG
-          , codepage::type to_cp CP_DEFAULT_TEMPLATE_ARG
-          , bom::type from_bo BOM_DEFAULT_TEMPLATE_ARG
-          , bom::type to_bo BOM_DEFAULT_TEMPLATE_ARG
-          , typename std::enable_if<
-                from_cp == to_cp && from_bo == to_bo, int>::type = 0>
-inline std::string convert(std::string const& bytes)
-{
-    return bytes;
-}
-#else
-// need c++11
-#endif
+private:
+    std::optional<T> value_;
+};
 
-// UnicodeToANSI
-template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline std::string UnicodeToANSI(std::wstring const& wstr)
+template <>
+class task_promise<void> : public task_promise_base
 {
-    return encode<codepage::cp_default, bo>(wstr);
-}
+public:
+    pipeline::task<void> get_return_object();
 
-template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline codec::char_ptr UnicodeToANSI(wchar_t const* wstr
-                                     , int in_size, int& out_size)
-{
-    return std::move(encode<codepage::cp_default, bo>(wstr, in_size, out_size));
-}
+    void return_void() noexcept
+    {}
 
-// ANSIToUnicode
-template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline std::wstring ANSIToUnicode(std::string const& bytes)
-{
-    return decode<codepage::cp_default, bo>(bytes);
-}
+    void result()
+    {
+        if (error_)
+        {
+            std::rethrow_exception(error_);
+        }
+    }
+};
 
-template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline codec::wchar_ptr ANSIToUnicode(char const* bytes, int in_size
-                                      , int& out_size)
+// started on call, destroys itself at the end; must not throw.
+struct detached
 {
-    return std::move(decode<codepage::cp_default, bo>(bytes, in_size
-                                                      , out_size));
-}
+    struct promise_type
+    {
+        detached get_return_object() const noexcept
+        {
+            return {};
+        }
 
-// UnicodeToUTF8
-template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline std::string UnicodeToUTF8(std::wstring const& wstr)
-{
-    return encode<codepage::cp_utf8, bo>(wstr);
-}
+        std::suspend_never initial_suspend() const noexcept
+        {
+            return {};
+        }
 
-template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline codec::char_ptr UnicodeToUTF8(wchar_t const* wstr, int in_size
-                                     , int& out_size)
-{
-    return std::move(encode<codepage::cp_utf8, bo>(wstr, in_size, out_size));
-}
+        std::suspend_never final_suspend() const noexcept
+        {
+            return {};
+        }
 
-// UTF8ToUnicode
-template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline std::wstring UTF8ToUnicode(std::string const& bytes)
-{
-    return decode<codepage::cp_utf8, bo>(bytes);
-}
+        void return_void() const noexcept
+        {}
 
-template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline codec::wchar_ptr UTF8ToUnicode(char const* bytes, int in_size
-                                      , int& out_size)
-{
-    return std::move(decode<codepage::cp_utf8, bo>(bytes, in_size, out_size));
-}
+        void unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+    };
+};
 
-// UnicodeToGB2312
-template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline std::string UnicodeToGB2312(std::wstring const& wstr)
-{
-    return encode<codepage::cp_gb2312, bo>(wstr);
-}
+}  // namespace detail
 
-template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline codec::char_ptr UnicodeToGB2312(wchar_t const* wstr, int in_size
-                                       , int& out_size)
+namespace pipeline
 {
-    return std::move(encode<codepage::cp_gb2312, bo>(wstr, in_size, out_size));
-}
 
-// GB2312ToUnicode
-template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline std::wstring GB2312ToUnicode(std::string const& bytes)
+//
+// Lazy coroutine, it starts when awaited and resumes the awaiting one when
+// done. Exceptions are rethrown by co_await.
+//
+template <class T>
+class task
 {
-    return decode<codepage::cp_gb2312, bo>(bytes);
-}
+public:
+    typedef detail::task_promise<T> promise_type;
+    typedef std::coroutine_handle<promise_type> handle_type;
 
-template <bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline codec::wchar_ptr GB2312ToUnicode(char const* bytes, int in_size
-                                        , int& out_size)
-{
-    return std::move(decode<codepage::cp_gb2312, bo>(bytes, in_size, out_size));
-}
+    explicit task(handle_type h = nullptr)
+        : h_(h)
+    {}
 
-} // namespace una
+    task(task&& other) noexcept
+        : h_(std::exchange(other.h_, nullptr))
+    {}
+
+    task& operator=(task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            h_ = std::exchange(other.h_, nullptr);
+        }
+        return *this;
+    }
+
+    ~task()
+    {
+        reset();
+    }
 
-namespace codepage = una::codepage;
-namespace bom = una::bom;
+    auto operator co_await() const noexcept
+    {
+        struct awaiter
+        {
+            handle_type h;
 
-using una::codec;
-using una::encode;
-using una::decode;
-using una::convert;
+            bool await_ready() const noexcept
+            {
+                return !h || h.done();
+            }
 
-using una::UnicodeToANSI;
-using una::ANSIToUnicode;
+            std::coroutine_handle<>
+            await_suspend(std::coroutine_handle<> caller) noexcept
+            {
+                h.promise().continuation_ = caller;
+                return h;
+            }
 
-using una::UnicodeToUTF8;
-using una::UTF8ToUnicode;
+            T await_resume()
+            {
+                return h.promise().result();
+            }
+        };
+        return awaiter{ h_ };
+    }
 
-using una::UnicodeToGB2312;
-using una::GB2312ToUnicode;
+private:
+    void reset()
+    {
+        if (h_)
+        {
+            h_.destroy();
+            h_ = nullptr;
+        }
+    }
 
-} // namespace ymh
+private:
+    handle_type h_;
+};
 
-/*****************************************************************************/
-/* Others */
+}  // namespace pipeline
 
-namespace ymh
+namespace detail
 {
-namespace una
+
+template <class T>
+inline pipeline::task<T> task_promise<T>::get_return_object()
 {
-namespace detail
+    return pipeline::task<T>(
+        std::coroutine_handle<task_promise<T>>::from_promise(*this));
+}
+
+inline pipeline::task<void> task_promise<void>::get_return_object()
 {
-namespace utf8
+    return pipeline::task<void>(
+        std::coroutine_handle<task_promise<void>>::from_promise(*this));
+}
+
+struct when_all_state
 {
+    std::atomic<std::size_t> count;
+    std::coroutine_handle<> waiter;
+    std::mutex mutex;
+    std::exception_ptr error;  // the first one
+};
 
-// byte is utf8 character?
-//
-// requires：
-//     - bytes length >= step;
-//     - 1 <= step <= 6.
-//
-// @note ascii if step == 1
-//
-// return step if true else 0.
-inline std::uint8_t step_bytes(char const* bytes, int /*in_size*/
-                               , std::uint8_t step)
+template <class T, class Result>
+detached when_all_one(pipeline::task<T>& t, Result* result
+                      , when_all_state& state)
 {
-    // single byte (ascii)
-    //    0xxxxxxx
-    // -> 00000000
-    if (step == 1)
+    try
     {
-        return ((static_cast<unsigned char>(*bytes) >> 7) == 0) ? 1 : 0;
+        if constexpr (std::is_void<T>::value)
+        {
+            co_await t;
+        }
+        else
+        {
+            result->emplace(co_await t);
+        }
     }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (!state.error)
+        {
+            state.error = std::current_exception();
+        }
+    }
+    if (state.count.fetch_sub(1) == 1)
+    {
+        state.waiter.resume();
+    }
+}
 
-    // invalid
-    if (step > 6)
+template <class T, class Result>
+struct when_all_awaiter
+{
+    std::vector<pipeline::task<T>>& tasks;
+    std::vector<Result>& results;
+    when_all_state& state;
+
+    bool await_ready() const noexcept
     {
-        return 0;
+        return tasks.empty();
     }
 
-    // multi bytes
-    //      110xxxxx 10xxxxxx
-    //  ->  00000110 00000010
-    //
-    // step  = 2
-    // 5     = 7 - step         = 8 - step [x 1] - 1 [x 0]
-    // 0x06  = 2^(step + 1) - 2 = 2^(2 + 1) - 2
-    //
-    //      1110xxxxx 10xxxxxx 10xxxxxx
-    //  ->  000001110 00000010 00000010
-    //
-    // step  = 3
-    // 4     = 7 - step         = 8 - step [x 1] - 1 [x 0] = 5
-    // 0x0E  = 2^(step + 1) - 2 = 2^(3 + 1) - 2
-    if ((static_cast<unsigned char>(*bytes++) >> (7 - step))
-        != static_cast<std::uint8_t>(std::pow(2.0, step + 1) - 2))
+    bool await_suspend(std::coroutine_handle<> h)
     {
-        return 0;
+        state.waiter = h;
+        state.count.store(tasks.size() + 1);
+        for (std::size_t i = 0; i != tasks.size(); ++i)
+        {
+            when_all_one(tasks[i], results.empty() ? nullptr : &results[i]
+                         , state);
+        }
+        return state.count.fetch_sub(1) != 1;
     }
 
-    for (std::uint8_t i = 0; i != (step - 1); ++i)
+    void await_resume()
     {
-        if (static_cast<unsigned char>(*bytes++) >> 6 != 0x02)
+        if (state.error)
         {
-            return 0;
+            std::rethrow_exception(state.error);
         }
     }
+};
 
-    return step;
-}
+template <class T>
+struct sync_wait_state
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+    std::exception_ptr error;
+    std::optional<typename std::conditional<std::is_void<T>::value
+                                            , char, T>::type> result;
+};
 
-inline bool is_utf8(char const* bytes, int in_size)
+template <class T>
+detached sync_wait_one(pipeline::task<T>& t, sync_wait_state<T>& state)
 {
-    for (int i = 0; i != in_size; )
+    try
     {
-        CONSTEXPR std::uint8_t utf8_max_bytes = 6;
-        std::uint8_t const k = (in_size - i > utf8_max_bytes)
-        ? utf8_max_bytes : static_cast<std::uint8_t>(in_size - i);
-
-        for (std::uint8_t j = 1; j <= k; ++j)
-            // [1, utf8_max_bytes]
+        if constexpr (std::is_void<T>::value)
         {
-            if (step_bytes(bytes + i, in_size, j))
-            {
-                // @warning quick check:
-                //          comment if (j >= 2) scoped code。
-                // if (j >= 2)
-                // {
-                //   return true;
-                // }
-
-                i += j;
-                break;
-            }
-            else if (j == k)
-            {
-                // @warning relax check
-                return (k < utf8_max_bytes);
-                // return false;
-            }
+            co_await t;
+        }
+        else
+        {
+            state.result.emplace(co_await t);
         }
     }
-    return true;
+    catch (...)
+    {
+        state.error = std::current_exception();
+    }
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.done = true;
+    state.cv.notify_all();
 }
 
-inline bool is_utf8(std::string const& bytes)
+}  // namespace detail
+
+namespace pipeline
+{
+
+// run tasks concurrently, results are in order of tasks. The first
+// exception is rethrown after all of them are done.
+template <class T>
+task<std::vector<T>> when_all(std::vector<task<T>> tasks)
 {
-    auto const in_size = bytes.size();
-    if ((std::numeric_limits<int>::max)() < in_size)
+    std::vector<std::optional<T>> results(tasks.size());
+    detail::when_all_state state;
+    co_await detail::when_all_awaiter<T, std::optional<T>>{
+        tasks, results, state };
+
+    std::vector<T> values;
+    values.reserve(results.size());
+    for (auto& r : results)
     {
-        throw std::system_error(std::make_error_code
-                                (std::errc::result_out_of_range)
-                                , "Input character's size is out of range");
+        values.push_back(std::move(*r));
     }
+    co_return values;
+}
 
-    return is_utf8(const_cast<char const*>(bytes.data())
-                   , static_cast<int>(in_size));
+inline task<void> when_all(std::vector<task<void>> tasks)
+{
+    std::vector<char> results;
+    detail::when_all_state state;
+    co_await detail::when_all_awaiter<void, char>{ tasks, results, state };
 }
 
-}  // namespace utf8
+// block the calling thread until the task is done.
+template <class T>
+T sync_wait(task<T> t)
+{
+    detail::sync_wait_state<T> state;
+    detail::sync_wait_one(t, state);
 
-inline codepage::type hint_codepage(char const* bytes, int in_size
-                                    , bom::type* bo = nullptr)
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.cv.wait(lock, [&state] { return state.done; });
+    if (state.error)
+    {
+        std::rethrow_exception(state.error);
+    }
+    if constexpr (!std::is_void<T>::value)
+    {
+        return std::move(*state.result);
+    }
+}
+
+//
+// Bounded queue between stages, push waits while it's full and pop waits
+// while it's empty. Waiters are resumed on the executor they passed.
+//
+template <class T>
+class channel
 {
-    // check bom bytes order mark.
-    using namespace codepage;
-    static codepage::type const cps[] = { cp_default
-                                          , cp_utf8
-                                          , cp_gb2312
-                                          , cp_gb18030
-                                          , cp_ucs2_le
-                                          , cp_ucs2_be };
-    size_t const cps_size = sizeof(cps) / sizeof(*cps);
+private:
+    struct push_awaiter;
+    struct pop_awaiter;
 
-    for (size_t i = 0; i != cps_size; ++i)
+public:
+    explicit channel(std::size_t capacity = 4)
+        : capacity_((std::max)(capacity, std::size_t(1))), closed_(false)
+    {}
+
+    channel(channel const&) = delete;
+    channel& operator=(channel const&) = delete;
+
+    // co_await yields false if the channel is closed, value is dropped.
+    push_awaiter push(executor& ex, T value)
     {
-        auto const bom = get_bom(cps[i]);
-        auto const bom_size = bom.first;
-        auto const bom_chars = bom.second;
+        return push_awaiter{ this, &ex, std::move(value), false, nullptr };
+    }
 
-        if (!bom_chars || in_size < bom_size)
-        {
-            continue;
-        }
+    // co_await yields std::optional<T>, empty once closed and drained.
+    pop_awaiter pop(executor& ex)
+    {
+        return pop_awaiter{ this, &ex, std::nullopt, nullptr };
+    }
 
-        auto p_bytes = bytes;
-        for (auto p_bom = bom_chars; p_bom < bom_chars + bom_size
-             ; ++p_bom, ++p_bytes)
+    // wake up all waiters, values in queue can still be popped.
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        for (auto w : pushers_)
         {
-            if (*p_bom != static_cast<decltype(*p_bom)>(*p_bytes))
-            {
-                break;
-            }
+            w->ex->post(w->h);
         }
-
-        if (p_bytes - bytes == bom_size)
+        pushers_.clear();
+        for (auto w : poppers_)
         {
-            if (bo)
-            {
-                *bo = bom::bomb;
-            }
-            return cps[i];
+            w->ex->post(w->h);
         }
+        poppers_.clear();
     }
 
-    // check content.
-#if defined(_WIN32)
-    if (ucs2_le::is_ucs2_le(bytes, in_size))
+private:
+    struct push_awaiter
     {
-        if (bo)
+        channel* ch;
+        executor* ex;
+        T value;
+        bool ok = false;
+        std::coroutine_handle<> h = nullptr;
+
+        bool await_ready() const noexcept
         {
-            *bo = bom::nobomb;
+            return false;
         }
-        return cp_ucs2_le;
-    }
-#endif  // _WIN32
 
-    if (utf8::is_utf8(bytes, in_size))
-    {
-        if (bo)
+        bool await_suspend(std::coroutine_handle<> caller)
         {
-            *bo = bom::nobomb;
+            std::lock_guard<std::mutex> lock(ch->mutex_);
+            if (ch->closed_)
+            {
+                return false;
+            }
+            ok = true;
+            if (!ch->poppers_.empty())
+                // hand over to a waiting consumer.
+            {
+                auto const w = ch->poppers_.front();
+                ch->poppers_.pop_front();
+                w->value.emplace(std::move(value));
+                w->ex->post(w->h);
+                return false;
+            }
+            if (ch->queue_.size() < ch->capacity_)
+            {
+                ch->queue_.push_back(std::move(value));
+                return false;
+            }
+            ok = false;
+            h = caller;
+            ch->pushers_.push_back(this);
+            return true;
         }
-        return cp_utf8;
-    }
 
-    return cp_default; // can't check codepage
-}
+        bool await_resume() const noexcept
+        {
+            return ok;
+        }
+    };
 
-inline codepage::type hint_codepage(std::string const& bytes
-                                    , bom::type* bo = nullptr)
-{
-    auto const in_size = bytes.size();
-    if ((std::numeric_limits<int>::max)() < in_size)
+    struct pop_awaiter
     {
-        throw std::system_error(std::make_error_code
-                                (std::errc::result_out_of_range)
-                                , "Input character's size is out of range");
-    }
+        channel* ch;
+        executor* ex;
+        std::optional<T> value;
+        std::coroutine_handle<> h = nullptr;
 
-    return hint_codepage(const_cast<char const*>(bytes.data())
-                         , static_cast<int>(in_size), bo);
-}
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
 
-}  // namespace detail
+        bool await_suspend(std::coroutine_handle<> caller)
+        {
+            std::lock_guard<std::mutex> lock(ch->mutex_);
+            if (!ch->queue_.empty())
+            {
+                value.emplace(std::move(ch->queue_.front()));
+                ch->queue_.pop_front();
+                if (!ch->pushers_.empty())
+                    // room for a waiting producer.
+                {
+                    auto const w = ch->pushers_.front();
+                    ch->pushers_.pop_front();
+                    ch->queue_.push_back(std::move(w->value));
+                    w->ok = true;
+                    w->ex->post(w->h);
+                }
+                return false;
+            }
+            if (ch->closed_)
+            {
+                return false;
+            }
+            h = caller;
+            ch->poppers_.push_back(this);
+            return true;
+        }
 
-inline codepage::type hint_codepage(char const* bytes, int in_size
-                                    , bom::type& bo)
-{
-    return detail::hint_codepage(bytes, in_size, &bo);
-}
+        std::optional<T> await_resume()
+        {
+            return std::move(value);
+        }
+    };
 
-inline codepage::type hint_codepage(char const* bytes, int in_size)
-{
-    return detail::hint_codepage(bytes, in_size);
-}
+private:
+    std::size_t capacity_;
+    std::mutex mutex_;
+    std::deque<T> queue_;
+    std::deque<push_awaiter*> pushers_;
+    std::deque<pop_awaiter*> poppers_;
+    bool closed_;
+};
 
-inline codepage::type hint_codepage(std::string const& bytes, bom::type& bo)
-{
-    return detail::hint_codepage(bytes, &bo);
-}
+}  // namespace pipeline
 
-inline codepage::type hint_codepage(std::string const& bytes)
+namespace detail
 {
-    return detail::hint_codepage(bytes);
-}
 
-inline bool is_ascii(char const* bytes, int in_size)
+struct chunks_state
 {
-    for (int i = 0; i != in_size; ++i)
+    chunks_state(pipeline::executor& io, pipeline::executor& cpu
+                 , std::size_t capacity)
+        : io(io), cpu(cpu), raw(capacity), wide(capacity)
+        , cp(codepage::cp_default), bo(bom::nobomb)
+    {}
+
+    void fail(std::exception_ptr e)
     {
-        if (static_cast<unsigned char>(*bytes++) >> 7)
         {
-            return false;
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error)
+            {
+                error = e;
+            }
         }
+        raw.close();
+        wide.close();
     }
-    return true;
-}
 
-inline bool is_ascii(std::string const& bytes)
+    pipeline::executor& io;
+    pipeline::executor& cpu;
+    pipeline::channel<std::string> raw;
+    pipeline::channel<std::wstring> wide;
+    // set before the first decoded chunk, cp changes if UTF-8 of the
+    // ascii head fails later.
+    std::atomic<codepage::type> cp;
+    std::atomic<bom::type> bo;
+    std::mutex mutex;
+    std::exception_ptr error;
+};
+
+inline detached read_stage(std::shared_ptr<chunks_state> s
+                           , std::string filename, std::size_t chunk_size)
 {
-    auto const in_size = bytes.size();
-    if ((std::numeric_limits<int>::max)() < in_size)
+    try
     {
-        throw std::system_error(std::make_error_code
-                                (std::errc::result_out_of_range)
-                                , "Input character's size is out of range");
-    }
+        co_await s->io.schedule();
 
-    return is_ascii(const_cast<char const*>(bytes.data())
-                    , static_cast<int>(in_size));
+        std::ifstream ifile;
+        ifile.exceptions(std::ifstream::badbit);
+        ifile.open(filename.c_str()
+                   , std::ifstream::in | std::ifstream::binary);
+        if (!ifile)
+        {
+            throw std::system_error(
+                std::make_error_code(std::errc::no_such_file_or_directory)
+                , filename);
+        }
+        for ( ; ; )
+        {
+            std::string chunk(chunk_size, '\0');
+            ifile.read(&chunk[0], static_cast<std::streamsize>(chunk_size));
+            chunk.resize(static_cast<std::size_t>(ifile.gcount()));
+            if (chunk.empty() || !co_await s->raw.push(s->io
+                                                       , std::move(chunk)))
+            {
+                break;
+            }
+        }
+        s->raw.close();
+    }
+    catch (std::ios_base::failure const& e)
+    {
+        s->fail(std::make_exception_ptr(std::system_error(
+            std::make_error_code(std::errc::io_error), e.what())));
+    }
+    catch (...)
+    {
+        s->fail(std::current_exception());
+    }
 }
 
-template <class CharT>
-inline std::string file_data(CharT const* filename)
+// codepage is detected as ingest_text does: an ascii head is widened as
+// it is, the rest is speculated to be UTF-8 until it fails, then detected
+// again. Bytes decoded already stay decoded.
+inline detached decode_stage(std::shared_ptr<chunks_state> s)
 {
-    std::string text;
-
-    std::ifstream ifile;
-    ifile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
     try
     {
-        ifile.open(filename, std::ifstream::in | std::ifstream::binary);
-        std::filebuf* fbuf = ifile.rdbuf();
-        do
+        co_await s->cpu.schedule();
+
+        using namespace codepage;
+        std::shared_ptr<codec_impl> ci;  // none while ascii
+        std::string rest;
+        bool started = false;
+        utf8_validator v;
+        bool speculating = false;
+        for ( ; ; )
         {
-            auto const fbuf_size = fbuf->in_avail();
-            if (fbuf_size < 0)
+            auto chunk = co_await s->raw.pop(s->cpu);
+            auto const end = !chunk;
+            if (chunk)
             {
-                break;
+                rest.append(*chunk);
+            }
+            if (!started)
+                // bom or UCS-2 decides the codepage for the whole file.
+            {
+                if (rest.empty())
+                {
+                    break;
+                }
+                started = true;
+                auto bo = bom::nobomb;
+                auto const cp = hint_codepage(rest.data(), rest.size(), &bo
+                                              , !end);
+                if (bo == bom::bomb || cp == cp_ucs2_le || cp == cp_ucs2_be)
+                {
+                    rest.erase(0, (bo == bom::bomb) ? get_bom(cp).first : 0);
+                    ci = codec_impl::create_instance(cp, bom::nobomb);
+                    s->bo = bo;
+                }
+                s->cp = ci ? cp : cp_utf8;
             }
-            auto const text_size = text.size();
-            text.resize(text_size
-                        + static_cast<std::string::size_type>(fbuf_size));
 
-            auto const sget_size = fbuf->sgetn((char*)(text.data() + text_size)
-                                               , fbuf_size);
-            if (sget_size != fbuf_size)
+            std::wstring wide;
+            auto unfed = chunk ? chunk->size() : 0;  // tail of rest
+            if (!ci)
             {
-                text.erase(text_size
-                           + static_cast<std::string::size_type>(sget_size));
+                auto const n = static_cast<std::size_t>(
+                    skip_ascii(rest.data(), rest.data() + rest.size())
+                    - rest.data());
+                wide.assign(rest.begin(), rest.begin() + n);
+                rest.erase(0, n);
+                if (!rest.empty())
+                {
+                    ci = codec_impl::create_instance(cp_utf8, bom::nobomb);
+                    speculating = true;
+                    unfed = rest.size();
+                }
             }
-        } while (fbuf->sgetc() != std::ifstream::traits_type::eof());
+            if (speculating
+                && (!v.feed(rest.data() + rest.size() - unfed, unfed)
+                    || (end && !v.finish())))
+                // not UTF-8, the rest is Latin-1 or default.
+            {
+                speculating = false;
+                s->cp = latin1::is_latin1(rest.data(), rest.size())
+                    ? cp_latin1 : cp_default;
+                ci = codec_impl::create_instance(s->cp, bom::nobomb);
+            }
+
+            auto const m = !ci ? 0 : end ? rest.size()
+                : complete_prefix(s->cp, rest.data(), rest.size());
+            if (m)
+            {
+                auto const head = wide.size();
+                std::size_t out_size = 0;
+                stats_scope scope(s->cp, stats::wide, m);
+                ci->decode_impl(rest.data(), m, out_size
+                                , [&wide, head](std::size_t n) -> wchar_t*
+                                {
+                                    wide.resize(head + n);
+                                    return &wide[head];
+                                });
+                scope.done(sizeof(wchar_t) * out_size);
+                wide.resize(head + out_size);
+                rest.erase(0, m);
+            }
+            if (!wide.empty() && !co_await s->wide.push(s->cpu
+                                                        , std::move(wide)))
+            {
+                s->raw.close();
+                break;
+            }
+            if (end)
+            {
+                break;
+            }
+        }
+        s->wide.close();
     }
-    catch (std::ifstream::failure const& e)
+    catch (...)
     {
-        throw std::system_error(
-            std::make_error_code(std::errc::no_such_file_or_directory)
-            , e.what());
+        s->fail(std::current_exception());
     }
-
-    return std::move(text);
 }
 
-#if !defined(_MSC_VER)
-template <>
-inline std::string file_data<wchar_t>(wchar_t const* wfilename)
-{
-    return file_data<char>(codec(codepage::cp_default
-                                 , bom::nobomb).encode(wfilename).c_str());
-}
-#endif // !_MSC_VER
-
-inline std::string file_data(std::string const& filename)
-{
-    return file_data(filename.c_str());
-}
+}  // namespace detail
 
-inline std::string file_data(std::wstring const& wfilename)
+namespace pipeline
 {
-    return file_data(wfilename.c_str());
-}
 
-template <class T>
-inline std::string file_data(T const& filename, std::error_code& ec)
+//
+// Decoded chunks of a file as an awaitable generator, reading runs on io
+// and decoding on cpu ahead of the consumer by capacity chunks.
+//
+//     decoded_chunks chunks(io, cpu, "demo.txt");
+//     std::wstring chunk;
+//     while (co_await chunks.next(chunk))
+//     {
+//     }
+//
+class decoded_chunks
 {
-    try
+public:
+    decoded_chunks(executor& io, executor& cpu, std::string const& filename
+                   , std::size_t capacity = 4
+                   , std::size_t chunk_size = detail::g_chunk_size)
+        : s_(std::make_shared<detail::chunks_state>(io, cpu, capacity))
     {
-        return std::move(file_data(filename));
+        detail::read_stage(s_, filename
+                           , (std::max)(chunk_size, std::size_t(16)));
+        detail::decode_stage(s_);
     }
-    catch (std::system_error const& e)
+
+    decoded_chunks(decoded_chunks const&) = delete;
+    decoded_chunks& operator=(decoded_chunks const&) = delete;
+
+    // stop stages if they are still running.
+    ~decoded_chunks()
     {
-        ec = e.code();
+        s_->raw.close();
+        s_->wide.close();
     }
-    return std::string();
-}
 
-template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
-          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline std::string string_text(std::string const& raw)
-{
-    bom::type bo_raw = codec::nobomb;
-    auto const cp_raw = hint_codepage(raw, bo_raw);
-    if (cp == cp_raw && bo == bo_raw)
+    // false at the end, errors of stages are rethrown. Resumes on cpu.
+    task<bool> next(std::wstring& chunk)
     {
-        return std::move(raw);
+        auto value = co_await s_->wide.pop(s_->cpu);
+        if (!value)
+        {
+            std::lock_guard<std::mutex> lock(s_->mutex);
+            if (s_->error)
+            {
+                std::rethrow_exception(s_->error);
+            }
+            co_return false;
+        }
+        chunk = std::move(*value);
+        co_return true;
     }
-    return std::move(codec(cp, bo)(codec(cp_raw, bo_raw)(raw)));
-}
 
-template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
-          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline std::string
-string_text(std::string const& raw, std::error_code& ec)
-{
-    try
+    // detected codepage, cp_utf8 for an ascii head until the text shows
+    // otherwise, final after the last chunk.
+    codepage::type source_codepage() const
     {
-        return std::move(string_text<cp, bo>(raw));
+        return s_->cp;
     }
-    catch (std::system_error const& e)
+
+    bom::type source_bom() const
     {
-        ec = e.code();
+        return s_->bo;
     }
-    return std::string();
-}
 
-inline std::wstring wstring_text(std::string const& raw)
+private:
+    std::shared_ptr<detail::chunks_state> s_;
+};
+
+}  // namespace pipeline
+
+namespace detail
 {
-    bom::type bo = codec::nobomb;
-    auto const cp = hint_codepage(raw, bo);
-    return std::move(codec(cp, bo)(raw));
-}
 
-inline std::wstring wstring_text(std::string const& raw, std::error_code& ec)
+// close channel on scope exit, so the other side stops too.
+template <class T>
+struct channel_closer
 {
-    try
-    {
-        return std::move(wstring_text(raw));
-    }
-    catch (std::system_error const& e)
+    pipeline::channel<T>& ch;
+
+    ~channel_closer()
     {
-        ec = e.code();
+        ch.close();
     }
-    return std::wstring();
-}
-
-template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
-          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline std::string file_text(std::string const& filename)
-{
-    auto const text_raw = file_data(filename);
-    return std::move(string_text<cp, bo>(text_raw));
-}
+};
 
-template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
-          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline std::string
-file_text(std::string const& filename, std::error_code& ec)
+template <codepage::type cp, bom::type bo>
+pipeline::task<void> encode_stage(pipeline::executor& cpu
+                                  , pipeline::decoded_chunks& in
+                                  , pipeline::channel<std::string>& out)
 {
-    auto const text_raw = file_data(filename, ec);
-    return std::move(string_text<cp, bo>(text_raw, ec));
-}
+    channel_closer<std::string> closer{ out };
+    co_await cpu.schedule();
 
-inline std::wstring file_text(std::wstring const& wfilename)
-{
-    auto const text_raw = file_data(wfilename);
-    return std::move(wstring_text(text_raw));
+    auto const ci = codec_impl::create_instance(cp, bom::nobomb);
+    auto first = true;
+    std::wstring wide;
+    while (co_await in.next(wide) || first)
+    {
+        std::string bytes;
+        if (first && bo == bom::bomb)
+        {
+            auto const b = get_bom(cp);
+            bytes.assign(b.second, b.second + b.first);
+        }
+        auto const skip = bytes.size();
+        first = false;
+        if (!wide.empty())
+        {
+            stats_scope scope(stats::wide, cp, sizeof(wchar_t) * wide.size());
+            std::size_t out_size = 0;
+            ci->encode_impl(wide.data(), wide.size(), out_size
+                            , [&bytes, skip](std::size_t n) -> char*
+                            {
+                                bytes.resize(skip + n);
+                                return &bytes[skip];
+                            });
+            bytes.resize(skip + out_size);
+            scope.done(out_size);
+            wide.clear();
+        }
+        if (!bytes.empty() && !co_await out.push(cpu, std::move(bytes)))
+        {
+            break;
+        }
+    }
 }
 
-inline std::wstring
-file_text(std::wstring const& wfilename, std::error_code& ec)
+inline pipeline::task<void> write_stage(pipeline::executor& io
+                                        , pipeline::channel<std::string>& in
+                                        , std::string filename
+                                        , std::uint64_t& written)
 {
-    auto const text_raw = file_data(wfilename, ec);
-    return std::move(wstring_text(text_raw, ec));
-}
+    channel_closer<std::string> closer{ in };
+    co_await io.schedule();
 
-inline size_t save_file_data(std::string const& filename
-                             , std::string const& data
-                             , std::ios_base::openmode mode
-                             = std::ios_base::out|std::ios_base::binary)
-{
     std::ofstream ofile;
-    ofile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
+    ofile.exceptions(std::ofstream::failbit | std::ofstream::badbit);
     try
     {
-        ofile.open(filename.c_str(), mode);
-        ofile.write(data.data(), data.size());
+        ofile.open(filename.c_str()
+                   , std::ofstream::out | std::ofstream::binary);
+        while (auto bytes = co_await in.pop(io))
+        {
+            ofile.write(bytes->data()
+                        , static_cast<std::streamsize>(bytes->size()));
+            written += bytes->size();
+        }
         ofile.close();
     }
     catch (std::ofstream::failure const& e)
@@ -1756,96 +9279,34 @@ inline size_t save_file_data(std::string const& filename
             std::make_error_code(std::errc::no_such_file_or_directory)
             , e.what());
     }
-    return data.size();
-}
-
-inline size_t save_file_data(std::wstring const& wfilename
-                             , std::string const& data
-                             , std::ios_base::openmode mode
-                             = std::ios_base::out|std::ios_base::binary)
-{
-    return save_file_data(encode<codec::cp_default, codec::nobomb>(wfilename)
-                          , data, mode);
 }
 
-template <class T>
-inline size_t save_file_data(T const& filename
-                             , std::string const& data
-                             , std::error_code& ec
-                             , std::ios_base::openmode mode
-                             = std::ios_base::out|std::ios_base::binary)
-{
-    try
-    {
-        return save_file_data(filename, data, mode);
-    }
-    catch (std::system_error const& e)
-    {
-        ec = e.code();
-    }
-    return 0U;
-}
+}  // namespace detail
 
-template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
-          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline size_t save_file_text(std::string const& filename
-                             , std::string const& text
-                             , std::ios_base::openmode mode
-                             = std::ios_base::out|std::ios_base::binary)
+namespace pipeline
 {
-    std::string const text_en = convert<codepage::cp_default, cp
-                                        , bom::bomb, bo>(text);
-    return save_file_data(filename, text_en, mode);
-}
 
+// convert file from detected codepage to cp, returns bytes written.
 template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
           , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline size_t save_file_text(std::string const& filename
-                             , std::string const& text
-                             , std::error_code& ec
-                             , std::ios_base::openmode mode
-                             = std::ios_base::out|std::ios_base::binary)
+task<std::uint64_t> transcode_file(executor& io, executor& cpu
+                                   , std::string from, std::string to
+                                   , std::size_t capacity = 4)
 {
-    try
-    {
-        return save_file_text<cp, bo>(filename, text, mode);
-    }
-    catch (std::system_error const& e)
-    {
-        ec = e.code();
-    }
-    return 0U;
+    decoded_chunks in(io, cpu, from, capacity);
+    channel<std::string> out(capacity);
+    std::uint64_t written = 0;
+
+    std::vector<task<void>> stages;
+    stages.push_back(detail::encode_stage<cp, bo>(cpu, in, out));
+    stages.push_back(detail::write_stage(io, out, to, written));
+    co_await when_all(std::move(stages));
+    co_return written;
 }
 
-template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
-          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline size_t save_file_text(std::wstring const& wfilename
-                             , std::wstring const& wtext
-                             , std::ios_base::openmode mode
-                             = std::ios_base::out|std::ios_base::binary)
-{
-    std::string const text_en = encode<cp, bo>(wtext);
-    return save_file_data(wfilename, text_en, mode);
-}
+}  // namespace pipeline
 
-template <codepage::type cp CP_DEFAULT_TEMPLATE_ARG
-          , bom::type bo BOM_DEFAULT_TEMPLATE_ARG>
-inline size_t save_file_text(std::wstring const& wfilename
-                             , std::wstring const& wtext
-                             , std::error_code& ec
-                             , std::ios_base::openmode mode
-                             = std::ios_base::out|std::ios_base::binary)
-{
-    try
-    {
-        return save_file_text<cp, bo>(wfilename, wtext, mode);
-    }
-    catch (std::system_error const& e)
-    {
-        ec = e.code();
-    }
-    return 0U;
-}
+#endif  // __cpp_impl_coroutine
 
 } // namespace una
 
@@ -1861,6 +9322,14 @@ using una::save_file_data;
 using una::file_text;
 using una::save_file_text;
 
+#if defined(YMH_UNA_WITH_DETECTION_CACHE) && !defined(_WIN32)
+namespace detection = una::detection;
+#endif  // YMH_UNA_WITH_DETECTION_CACHE && !_WIN32
+
+#if defined(__cpp_impl_coroutine)
+namespace pipeline = una::pipeline;
+#endif  // __cpp_impl_coroutine
+
 } // namespace ymh
 
 #endif  // YMH_UNA_HPP